@@ -0,0 +1,28 @@
+// src/FiltroInclinacion.cpp
+
+#include "FiltroInclinacion.h"
+#include <math.h>
+
+static const float GRADOS_POR_RADIAN = 57.29578f;
+
+void FiltroInclinacion::actualizar(int16_t acel_y, int16_t acel_z, float giro_grados_s, float dt_s) {
+  // Rotación alrededor de X: la gravedad pasa de Z a Y
+  float angulo_acel = atan2f((float)acel_y, (float)acel_z) * GRADOS_POR_RADIAN;
+
+  if (!iniciado || dt_s <= 0.0f || dt_s > 0.5f) {
+    // Primera muestra o hueco largo: el giroscopio no sirve, partir de la gravedad
+    angulo = angulo_acel;
+    iniciado = true;
+    return;
+  }
+
+  const float a = PALETA_TAU_FILTRO / (PALETA_TAU_FILTRO + dt_s);
+  angulo = a * (angulo + giro_grados_s * dt_s) + (1.0f - a) * angulo_acel;
+}
+
+int FiltroInclinacion::aJoystick(float angulo_max) const {
+  float v = angulo;
+  if (v < -angulo_max) v = -angulo_max;
+  if (v > angulo_max) v = angulo_max;
+  return (int)((v + angulo_max) * (4095.0f / (2.0f * angulo_max)) + 0.5f);
+}
@@ -0,0 +1,36 @@
+// src/FiltroInclinacion.h
+//
+// --- FILTRO COMPLEMENTARIO DE INCLINACIÓN ---
+// Fusiona el giroscopio X (rápido y limpio, pero deriva) con el ángulo que da
+// la gravedad en el acelerómetro (sin deriva, pero ruidoso y sensible a las
+// sacudidas):
+//   angulo = a * (angulo + giro * dt) + (1 - a) * atan2(acel_y, acel_z)
+// con a = tau / (tau + dt). Con tau = 0.15 s el ruido del acelerómetro queda
+// muy atenuado y la respuesta a un giro real es inmediata (la da el giroscopio),
+// así que la consola casi no necesita suavizar.
+
+#ifndef FILTRO_INCLINACION_H
+#define FILTRO_INCLINACION_H
+
+#include <stdint.h>
+
+#ifndef PALETA_TAU_FILTRO
+#define PALETA_TAU_FILTRO 0.15f // Segundos
+#endif
+
+class FiltroInclinacion {
+public:
+  // Incorpora una muestra cruda; dt_s es el tiempo desde la anterior
+  void actualizar(int16_t acel_y, int16_t acel_z, float giro_grados_s, float dt_s);
+
+  float anguloGrados() const { return angulo; }
+
+  // Ángulo -> rango del joystick 0-4095, saturando en +-angulo_max
+  int aJoystick(float angulo_max) const;
+
+private:
+  float angulo = 0.0f;
+  bool iniciado = false;
+};
+
+#endif // FILTRO_INCLINACION_H
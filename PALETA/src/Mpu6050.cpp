@@ -0,0 +1,131 @@
+// src/Mpu6050.cpp
+
+#include "Mpu6050.h"
+#include <Wire.h>
+
+// --- REGISTROS (hoja de registros MPU-6000/6050, rev. 4.2) ---
+static const uint8_t DIRECCION = 0x68;  // AD0 a GND
+static const uint8_t REG_SMPLRT_DIV = 0x19;
+static const uint8_t REG_CONFIG = 0x1A;
+static const uint8_t REG_GYRO_CONFIG = 0x1B;
+static const uint8_t REG_ACCEL_CONFIG = 0x1C;
+static const uint8_t REG_INT_PIN_CFG = 0x37;
+static const uint8_t REG_MOT_THR = 0x1F;
+static const uint8_t REG_MOT_DUR = 0x20;
+static const uint8_t REG_INT_ENABLE = 0x38;
+static const uint8_t REG_INT_STATUS = 0x3A;
+static const uint8_t REG_ACCEL_YOUT_H = 0x3D; // Y, Z, TEMP y GYRO_X siguen en orden
+static const uint8_t REG_PWR_MGMT_1 = 0x6B;
+static const uint8_t REG_PWR_MGMT_2 = 0x6C;
+static const uint8_t REG_WHO_AM_I = 0x75;
+
+TaskHandle_t Mpu6050::tarea_notificada = NULL;
+
+void IRAM_ATTR Mpu6050::isrDatoListo() {
+  BaseType_t despertar = pdFALSE;
+  if (tarea_notificada != NULL) vTaskNotifyGiveFromISR(tarea_notificada, &despertar);
+  if (despertar) portYIELD_FROM_ISR();
+}
+
+bool Mpu6050::escribirRegistro(uint8_t reg, uint8_t valor) {
+  Wire.beginTransmission(DIRECCION);
+  Wire.write(reg);
+  Wire.write(valor);
+  if (Wire.endTransmission() != 0) {
+    errores_i2c++;
+    return false;
+  }
+  return true;
+}
+
+bool Mpu6050::leerRafaga(uint8_t reg, uint8_t *buf, uint8_t n) {
+  Wire.beginTransmission(DIRECCION);
+  Wire.write(reg);
+  // Inicio repetido: el puntero de registro queda en 'reg' para la lectura
+  if (Wire.endTransmission(false) != 0 || Wire.requestFrom(DIRECCION, n) != n) {
+    errores_i2c++;
+    return false;
+  }
+  for (uint8_t i = 0; i < n; i++) buf[i] = Wire.read();
+  return true;
+}
+
+bool Mpu6050::begin(int pin_sda, int pin_scl, int pin_int, uint16_t hz) {
+  Wire.begin(pin_sda, pin_scl);
+  Wire.setClock(400000); // I2C rápido: la ráfaga de 8 bytes tarda ~250 us
+
+  uint8_t quien = 0;
+  if (!leerRafaga(REG_WHO_AM_I, &quien, 1) || quien != DIRECCION) return false;
+
+  if (hz < 4) hz = 4;
+  if (hz > 1000) hz = 1000;
+
+  escribirRegistro(REG_PWR_MGMT_1, 0x80); // Reset del dispositivo
+  delay(100);
+  escribirRegistro(REG_PWR_MGMT_1, 0x01);  // Despierto, reloj del PLL del giroscopio X
+  // Filtro pasa bajos interno por debajo de la mitad de la frecuencia de muestreo
+  escribirRegistro(REG_CONFIG, hz >= 400 ? 0x01 : (hz >= 200 ? 0x02 : 0x03)); // 184 / 94 / 44 Hz
+  escribirRegistro(REG_SMPLRT_DIV, (uint8_t)(1000 / hz - 1));
+  escribirRegistro(REG_GYRO_CONFIG, 0x08);  // +-500 dps
+  escribirRegistro(REG_ACCEL_CONFIG, 0x00); // +-2 g (igual que antes)
+  // INT activo en alto, push-pull, pulso de 50 us; cualquier lectura limpia el estado
+  escribirRegistro(REG_INT_PIN_CFG, 0x10);
+
+  tarea_notificada = xTaskGetCurrentTaskHandle();
+  this->pin_int = pin_int;
+  pinMode(pin_int, INPUT);
+  attachInterrupt(digitalPinToInterrupt(pin_int), isrDatoListo, RISING);
+
+  return escribirRegistro(REG_INT_ENABLE, 0x01); // DATA_RDY_EN
+}
+
+bool Mpu6050::esperarMuestra(uint32_t timeout_ms) {
+  if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeout_ms)) == 0) {
+    timeouts++;
+    return false;
+  }
+  muestras++;
+  return true;
+}
+
+bool Mpu6050::leerMovimiento(Movimiento &m) {
+  uint8_t buf[8];
+  if (!leerRafaga(REG_ACCEL_YOUT_H, buf, 8)) return false;
+  m.acel_y = (int16_t)((buf[0] << 8) | buf[1]);
+  m.acel_z = (int16_t)((buf[2] << 8) | buf[3]);
+  // buf[4..5]: temperatura
+  m.giro_x = (int16_t)(((buf[6] << 8) | buf[7]) - desvio_giro_x);
+  return true;
+}
+
+bool Mpu6050::calibrarGiro(int n) {
+  int32_t suma = 0;
+  int validas = 0;
+  desvio_giro_x = 0;
+  for (int i = 0; i < n; i++) {
+    Movimiento m;
+    if (!esperarMuestra(100) || !leerMovimiento(m)) continue;
+    suma += m.giro_x;
+    validas++;
+  }
+  if (validas == 0) return false;
+  desvio_giro_x = (int16_t)(suma / validas);
+  return true;
+}
+
+bool Mpu6050::activarDespertarPorMovimiento(uint8_t umbral) {
+  if (pin_int >= 0) detachInterrupt(digitalPinToInterrupt(pin_int));
+  escribirRegistro(REG_INT_ENABLE, 0x00);
+
+  escribirRegistro(REG_ACCEL_CONFIG, 0x01); // +-2 g, pasa altos de 5 Hz (solo cuenta el cambio)
+  escribirRegistro(REG_MOT_THR, umbral);
+  escribirRegistro(REG_MOT_DUR, 1);         // 1 ms por encima del umbral
+  escribirRegistro(REG_INT_PIN_CFG, 0x20);  // Activo en alto, retenido hasta leer INT_STATUS
+
+  uint8_t estado;
+  leerRafaga(REG_INT_STATUS, &estado, 1);   // Limpiar lo pendiente antes de armar
+  escribirRegistro(REG_INT_ENABLE, 0x40);   // MOT_EN
+
+  escribirRegistro(REG_PWR_MGMT_2, 0x47);   // Despertar a 5 Hz, giroscopio en espera
+  return escribirRegistro(REG_PWR_MGMT_1, 0x28); // CYCLE + sin sensor de temperatura, oscilador interno
+}
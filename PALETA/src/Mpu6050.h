@@ -0,0 +1,69 @@
+// src/Mpu6050.h
+//
+// --- DRIVER MÍNIMO DEL MPU6050 POR REGISTROS ---
+// Sustituye a Adafruit_MPU6050 en el mando: I2C a 400 kHz, muestreo marcado
+// por la interrupción de dato listo (pin INT del sensor) y lecturas en ráfaga
+// solo de los registros que se usan. El ISR despierta a la tarea que llamó a
+// begin() con una notificación de FreeRTOS; esperarMuestra() la consume.
+
+#ifndef MPU6050_H
+#define MPU6050_H
+
+#include <Arduino.h>
+
+// Frecuencia de muestreo del sensor (4-1000 Hz). Con el filtro pasa bajos
+// interno el reloj del giroscopio es de 1 kHz: divisor = 1000 / Hz - 1.
+#ifndef PALETA_MPU_HZ
+#define PALETA_MPU_HZ 200
+#endif
+
+class Mpu6050 {
+public:
+  // Escalas: acelerómetro a +-2 g, giroscopio a +-500 grados/s
+  static const int LSB_POR_G = 16384;
+  static constexpr float LSB_POR_GRADO_S = 65.5f;
+
+  // Lo que usa el filtro de inclinación (rotación alrededor de X)
+  struct Movimiento {
+    int16_t acel_y;
+    int16_t acel_z;
+    int16_t giro_x; // Ya sin el desvío medido en calibrarGiro()
+  };
+
+  // Configura el sensor y la interrupción. Devuelve false si no responde en el bus.
+  bool begin(int pin_sda, int pin_scl, int pin_int, uint16_t hz = PALETA_MPU_HZ);
+
+  // Bloquea hasta la próxima interrupción de dato listo (o hasta timeout_ms).
+  // Devuelve false si venció el tiempo.
+  bool esperarMuestra(uint32_t timeout_ms);
+
+  // Una ráfaga de 8 bytes: ACCEL_YOUT_H .. GYRO_XOUT_L (incluye TEMP, que se
+  // ignora: sale más barato que dos transacciones)
+  bool leerMovimiento(Movimiento &m);
+
+  // Promedia el giroscopio X durante 'n' muestras con el mando quieto
+  bool calibrarGiro(int n);
+
+  // Antes de dormir: deja el sensor en modo de bajo consumo (solo acelerómetro,
+  // despertando a 5 Hz) con la interrupción de movimiento. INT queda en alto
+  // (retenido) cuando la aceleración supera 'umbral' (2 mg por unidad), lo que
+  // sirve para despertar al ESP32 por EXT0. Se deshace con begin().
+  bool activarDespertarPorMovimiento(uint8_t umbral);
+
+  // Lectura en ráfaga de n registros consecutivos desde 'reg'
+  bool leerRafaga(uint8_t reg, uint8_t *buf, uint8_t n);
+  bool escribirRegistro(uint8_t reg, uint8_t valor);
+
+  // Estadísticas
+  uint32_t muestras = 0;
+  uint32_t errores_i2c = 0;
+  uint32_t timeouts = 0;
+  int16_t desvio_giro_x = 0;
+
+private:
+  static void IRAM_ATTR isrDatoListo();
+  static TaskHandle_t tarea_notificada;
+  int pin_int = -1;
+};
+
+#endif // MPU6050_H
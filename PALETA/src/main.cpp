@@ -1,8 +1,10 @@
 #include <esp_now.h>
 #include <WiFi.h>
-#include <Adafruit_MPU6050.h>
-#include <Adafruit_Sensor.h>
-#include <Wire.h>
+#include "esp_sleep.h"
+#include "driver/rtc_io.h"
+#include "Mpu6050.h"
+#include "FiltroInclinacion.h"
+#include "EmisorMando.h" // comun/Protocolo: trama compartida con la consola
 
 // ==========================================================
 // --- CONFIGURACIÓN DE JUGADOR Y RECEPTOR ---
@@ -18,18 +20,31 @@ uint8_t broadcastAddress[] = {0x94, 0xB5, 0x55, 0xF8, 0x4C, 0x48};
 #define I2C_SDA_PIN 21 
 #define I2C_SCL_PIN 22 
 #define PIN_BOTON_REMOTO 33 
+#define PIN_MPU_INT 32 // INT del MPU6050 (dato listo)
 
 // ==========================================================
-// --- ESTRUCTURA DE COMUNICACIÓN (DEBE COINCIDIR CON CONSOLA) ---
+// --- COMUNICACIÓN (comun/Protocolo/Protocolo.h, igual en la consola) ---
 // ==========================================================
-typedef struct struct_message {
-    int player_id;      // 4 bytes
-    int16_t joy_y_val;  // 2 bytes
-    bool btn_pressed;   // 1 byte
-} __attribute__((packed)) AccelData_t;
-
-AccelData_t myData;
-Adafruit_MPU6050 mpu;
+// Cada trama repite las últimas muestras como diferencias: la consola rehace
+// las que se pierdan sin pedir reenvíos (Protocolo.h)
+protocolo::TramaMando_t myData;
+EmisorMando emisor(PLAYER_ID);
+// La secuencia se guarda en RTC para seguir la cuenta tras el Deep Sleep
+RTC_DATA_ATTR uint8_t secuencia_guardada = 0;
+bool btn_pressed = false;
+
+// --- ENVÍO ADAPTATIVO Y SUEÑO ---
+// En movimiento se manda cada muestra que cambió lo suficiente (hasta PALETA_MPU_HZ) y,
+// tras el último cambio, PROTOCOLO_MUESTRAS_ANTERIORES más; quieto, solo una trama
+// cada MS_ENTRE_KEEPALIVE (EmisorMando::debeEnviar).
+// Tras MS_QUIETO_PARA_DORMIR sin moverse ni tocar el botón: Deep Sleep hasta
+// que el MPU6050 detecte movimiento (EXT0) o se presione el botón (EXT1).
+const uint32_t MS_QUIETO_PARA_DORMIR = 60000;
+const uint8_t UMBRAL_DESPERTAR = 20;             // 40 mg
+RTC_DATA_ATTR int16_t desvio_giro_guardado = 0; // Calibración que sobrevive al sueño
+Mpu6050 mpu;
+FiltroInclinacion filtro;
+uint32_t ultima_muestra_us = 0;
 esp_now_peer_info_t peerInfo;
 
 // --- VARIABLES PARA DEBOUNCE ---
@@ -42,13 +57,21 @@ void setup() {
   
   pinMode(PIN_BOTON_REMOTO, INPUT_PULLUP);
 
-  // 1. Inicializar I2C y MPU6050
-  Wire.begin(I2C_SDA_PIN, I2C_SCL_PIN);
-  if (!mpu.begin()) {
+  // 1. Inicializar I2C (400 kHz) y MPU6050 (+-2 g, interrupción de dato listo)
+  if (!mpu.begin(I2C_SDA_PIN, I2C_SCL_PIN, PIN_MPU_INT)) {
     Serial.println("¡Error al encontrar el MPU-6050!");
     while (1) yield();
   }
-  mpu.setAccelerometerRange(MPU6050_RANGE_2_G);
+  // Desvío del giroscopio: el mando debe estar quieto al encenderlo (~1 s a 200 Hz).
+  // Al despertar por movimiento se reutiliza el medido antes de dormir.
+  if (esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_UNDEFINED) {
+    mpu.calibrarGiro(PALETA_MPU_HZ);
+    desvio_giro_guardado = mpu.desvio_giro_x;
+  } else {
+    mpu.desvio_giro_x = desvio_giro_guardado;
+    emisor.fijarSecuencia(secuencia_guardada);
+    Serial.println("Despertado por movimiento o boton.");
+  }
 
   // 2. Configurar WiFi y ESP-NOW
   WiFi.mode(WIFI_STA);
@@ -67,44 +90,74 @@ void setup() {
     return;
   }
 
-  Serial.printf("Mando Jugador %d iniciado y listo.\n", PLAYER_ID);
+  Serial.printf("Mando Jugador %d iniciado y listo (%d Hz).\n", PLAYER_ID, PALETA_MPU_HZ);
 }
 
-void loop() {
-  sensors_event_t a, g, temp;
-  mpu.getEvent(&a, &g, &temp);
-
-  // --- 1. ASIGNAR ID DE JUGADOR ---
-  myData.player_id = PLAYER_ID;
+// Inclinación que recorre toda la pantalla: +-37.7 grados, el ángulo en el que
+// la gravedad da los +-6 m/s^2 en Y del mapeo anterior (solo acelerómetro)
+const float ANGULO_MAX_GRADOS = 37.7f;
+
+// --- Deep Sleep hasta que el mando se mueva o se presione el botón ---
+void dormir() {
+  Serial.println("Mando quieto: entrando en Deep Sleep.");
+  Serial.flush();
+  secuencia_guardada = emisor.secuencia();
+  esp_now_deinit();
+  WiFi.mode(WIFI_OFF);
+
+  mpu.activarDespertarPorMovimiento(UMBRAL_DESPERTAR);
+  esp_sleep_enable_ext0_wakeup((gpio_num_t)PIN_MPU_INT, 1);
+  // El pull-up del botón debe seguir activo en el dominio RTC
+  rtc_gpio_pullup_en((gpio_num_t)PIN_BOTON_REMOTO);
+  rtc_gpio_pulldown_dis((gpio_num_t)PIN_BOTON_REMOTO);
+  esp_sleep_pd_config(ESP_PD_DOMAIN_RTC_PERIPH, ESP_PD_OPTION_ON);
+  esp_sleep_enable_ext1_wakeup(1ULL << PIN_BOTON_REMOTO, ESP_EXT1_WAKEUP_ALL_LOW);
+  esp_deep_sleep_start();
+}
 
-  // --- 2. LÓGICA DE BOTÓN CON DEBOUNCE ---
+void loop() {
+  // El ritmo lo marca el sensor: se espera su interrupción en vez de delay()
+  // y cada trama sale con la muestra recién convertida (edad < 1 periodo)
+  if (!mpu.esperarMuestra(100)) return; // Sin interrupción: reintentar
+  Mpu6050::Movimiento m;
+  if (!mpu.leerMovimiento(m)) return;
+  uint32_t ahora_us = micros();
+  float dt_s = (ahora_us - ultima_muestra_us) * 1e-6f;
+  ultima_muestra_us = ahora_us;
+
+  // --- 1. LÓGICA DE BOTÓN CON DEBOUNCE ---
   int reading = digitalRead(PIN_BOTON_REMOTO);
   if (reading != lastPhysicalBtnState) {
     lastDebounceTime = millis();
   }
   if ((millis() - lastDebounceTime) > debounceDelay) {
-    myData.btn_pressed = (reading == LOW);
+    btn_pressed = (reading == LOW);
   }
   lastPhysicalBtnState = reading;
 
-  // --- 3. PROCESAR MOVIMIENTO (ACELERÓMETRO) ---
-  float accY = a.acceleration.y;
-  // Limitamos la inclinación para que no sea demasiado sensible
-  float inclinacion = constrain(accY, -6.0, 6.0);
-  // Mapeamos de -6.0/6.0 m/s^2 al rango del joystick 0-4095
-  myData.joy_y_val = map(inclinacion * 100, -600, 600, 0, 4095);
+  // --- 2. PROCESAR MOVIMIENTO (GIROSCOPIO + ACELERÓMETRO) ---
+  // Filtro complementario: ángulo limpio y sin retraso (FiltroInclinacion.h)
+  filtro.actualizar(m.acel_y, m.acel_z, m.giro_x / Mpu6050::LSB_POR_GRADO_S, dt_s);
+  // Mapeamos de -37.7/37.7 grados al rango del joystick 0-4095
+  int joy_y_val = filtro.aJoystick(ANGULO_MAX_GRADOS);
+
+  // --- 3. DECIDIR SI ENVIAR ---
+  uint32_t ahora_ms = millis();
+  if (!emisor.debeEnviar(ahora_ms, joy_y_val, btn_pressed)) {
+    if (emisor.msSinMovimiento(ahora_ms) >= MS_QUIETO_PARA_DORMIR) dormir();
+    return; // Quieto y sin tocar la trama de mantenimiento
+  }
 
-  // --- 4. ENVIAR DATOS ---
-  esp_err_t result = esp_now_send(broadcastAddress, (uint8_t *) &myData, sizeof(myData));
+  // --- 4. ENVIAR DATOS (muestra nueva + PROTOCOLO_MUESTRAS_ANTERIORES repetidas) ---
+  int bytes = emisor.armarTrama(micros(), joy_y_val, btn_pressed, myData);
+  esp_err_t result = esp_now_send(broadcastAddress, (uint8_t *) &myData, bytes);
 
   // --- DEBUG (Opcional, para ver en monitor serial del mando) ---
   /*
   if (result == ESP_OK) {
-    Serial.printf("ID: %d | Joy: %d | Btn: %d\n", myData.player_id, myData.joy_y_val, myData.btn_pressed);
+    Serial.printf("ID: %d | Seq: %u | Joy: %d | Btn: %d\n", PLAYER_ID, myData.cabecera.secuencia, joy_y_val, btn_pressed);
   } else {
     Serial.println("Error en el envío");
   }
   */
-
-  delay(20); // 50 Hz es suficiente para una respuesta fluida
 }
\ No newline at end of file
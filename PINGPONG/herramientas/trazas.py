@@ -0,0 +1,83 @@
+#!/usr/bin/env python3
+# herramientas/trazas.py
+#
+# --- LECTOR DEL REGISTRO DE LA CONSOLA (PC) ---
+# Por la UART salen líneas de texto ("[s.mmm] I ...\n") mezcladas con trazas
+# binarias de 14 bytes (src/Registro.h):
+#   0xA5 | traza | marca_us (u32) | a (u16) | b (u16) | c (u32), little-endian
+# Cada línea y cada traza salen de la consola en una sola escritura a la UART
+# (Registro.h), así que una traza solo puede empezar donde terminó la unidad
+# anterior: basta mirar el primer byte. Este script las separa e imprime todo
+# como texto, con el mismo formato que la simulación en PC
+# ("[s.mmm] T nombre a b c"). Reemplaza al monitor serie
+# mientras se capturan trazas; las teclas de comando se mandan con --enviar.
+#   python3 herramientas/trazas.py /dev/ttyUSB0 --enviar v
+#   python3 herramientas/trazas.py captura.bin     (volcado crudo de la UART)
+
+import argparse
+import struct
+import sys
+
+SINCRONIA_TRAZA = 0xA5
+BYTES_TRAZA = 14
+FORMATO_TRAZA = "<BBIHHI"
+
+# Mismo orden que enum Traza / NOMBRES_TRAZA (src/Registro.cpp)
+NOMBRES_TRAZA = [
+    "muestra_remota",  # jugador eje transito_us
+    "boton",           # pin presionado marca_us
+    "frame",           # filas bytes numero
+]
+
+
+def decodificar(leer, escribir):
+    """Lee bytes con leer(n) y escribe cada línea decodificada con escribir()."""
+    linea = bytearray()
+    while True:
+        b = leer(1)
+        if not b:
+            break
+        if not linea and b[0] == SINCRONIA_TRAZA:
+            resto = leer(BYTES_TRAZA - 1)
+            if len(resto) < BYTES_TRAZA - 1:
+                break
+            _, traza, marca_us, a, b_, c = struct.unpack(FORMATO_TRAZA, b + resto)
+            nombre = NOMBRES_TRAZA[traza] if traza < len(NOMBRES_TRAZA) else "?"
+            escribir("[%u.%03u] T %s %u %u %u" % (marca_us // 1000000, (marca_us // 1000) % 1000,
+                                                   nombre, a, b_, c))
+            continue
+        if b == b"\n":
+            escribir(linea.decode("utf-8", "replace").rstrip("\r"))
+            linea.clear()
+        else:
+            linea += b
+    if linea:
+        escribir(linea.decode("utf-8", "replace"))
+
+
+def main():
+    p = argparse.ArgumentParser(description="Decodifica el registro serie de la consola")
+    p.add_argument("origen", help="puerto serie (/dev/ttyUSB0, COM3) o archivo con el volcado crudo")
+    p.add_argument("--baudios", type=int, default=115200)
+    p.add_argument("--enviar", default="", help="teclas a mandar al abrir el puerto (p. ej. v)")
+    args = p.parse_args()
+
+    def imprimir(texto):
+        print(texto, flush=True)
+
+    if args.origen.startswith("/dev/") or args.origen.upper().startswith("COM"):
+        import serial  # pyserial (viene con PlatformIO)
+        with serial.Serial(args.origen, args.baudios, timeout=None) as puerto:
+            if args.enviar:
+                puerto.write(args.enviar.encode())
+            try:
+                decodificar(puerto.read, imprimir)
+            except KeyboardInterrupt:
+                pass
+    else:
+        with open(args.origen, "rb") as f:
+            decodificar(f.read, imprimir)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
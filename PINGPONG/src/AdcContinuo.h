@@ -0,0 +1,48 @@
+// src/AdcContinuo.h
+//
+// --- ADC1 EN MODO CONTINUO (DMA) PARA LOS JOYSTICKS LOCALES (solo ESP32) ---
+// El controlador digital del ADC1 recorre los canales de los joysticks a
+// 20 kHz y deja las muestras por DMA en el buffer del driver (adc_digi de
+// ESP-IDF 4.4). Una tarea de baja prioridad en el Core 0 vacía cada bloque,
+// promedia las ~32 muestras de cada canal (sobremuestreo), corrige la curva
+// del ADC con la calibración de fábrica (esp_adc_cal) y deja el resultado en
+// 0-4095. hal::leerADC() solo devuelve el último valor: la tarea de lógica ya
+// no espera ninguna conversión.
+// Con -D PINGPONG_ADC_CONTINUO=0 se vuelve a analogRead().
+
+#ifndef ADC_CONTINUO_H
+#define ADC_CONTINUO_H
+
+#include <stdint.h>
+
+#ifndef PINGPONG_ADC_CONTINUO
+#define PINGPONG_ADC_CONTINUO 1
+#endif
+
+class AdcContinuo {
+public:
+    static const uint32_t FRECUENCIA_HZ = 20000;   // Mínimo del controlador digital del ESP32
+    static const uint32_t BYTES_POR_BLOQUE = 128;  // 64 muestras: un bloque cada 3,2 ms
+
+    // Arranca el muestreo de los pines (solo los del ADC1: 32-39). Devuelve
+    // false si algún pin no sirve o el driver no arrancó; entonces muestrea()
+    // es false y la HAL sigue con analogRead().
+    static bool iniciar(const int *pines, int cantidad);
+
+    // true si el driver arrancó con este pin. El ADC1 queda tomado por el
+    // controlador digital: analogRead() sobre el pin ya no es válido.
+    static bool muestrea(int pin);
+
+    // Último valor filtrado y calibrado (0-4095) del pin. false hasta que la
+    // tarea procesa el primer bloque.
+    static bool leer(int pin, int &valor);
+
+    // Estadísticas
+    static uint32_t bloques;     // Bloques procesados
+    static uint32_t desbordes;   // La tarea no vació a tiempo el buffer del driver
+
+private:
+    static void tarea(void *parametro);
+};
+
+#endif // ADC_CONTINUO_H
@@ -0,0 +1,133 @@
+// src/AdcContinuo_esp32.cpp
+
+#include "AdcContinuo.h"
+#include <Arduino.h>
+#include <string.h>
+#include "driver/adc.h"
+#include "esp_adc_cal.h"
+
+// GPIO -> canal del ADC1 (-1: el pin no es del ADC1)
+static int canalDePin(int pin) {
+    switch (pin) {
+        case 36: return ADC1_CHANNEL_0;
+        case 37: return ADC1_CHANNEL_1;
+        case 38: return ADC1_CHANNEL_2;
+        case 39: return ADC1_CHANNEL_3;
+        case 32: return ADC1_CHANNEL_4;
+        case 33: return ADC1_CHANNEL_5;
+        case 34: return ADC1_CHANNEL_6;
+        case 35: return ADC1_CHANNEL_7;
+        default: return -1;
+    }
+}
+
+static const int CANALES = 8;
+static const int MAX_PINES = 4;
+
+// Último valor por canal (-1: todavía sin muestras). Escribe solo la tarea del ADC.
+static volatile int16_t valores[CANALES] = {-1, -1, -1, -1, -1, -1, -1, -1};
+static bool activo = false;
+static uint32_t canales_activos = 0; // Máscara de canales del patrón
+static esp_adc_cal_characteristics_t calibracion;
+static uint32_t mv_fondo_escala = 3300; // Tensión calibrada de la lectura 4095
+
+uint32_t AdcContinuo::bloques = 0;
+uint32_t AdcContinuo::desbordes = 0;
+
+bool AdcContinuo::iniciar(const int *pines, int cantidad) {
+    if (activo || cantidad <= 0 || cantidad > MAX_PINES) return false;
+
+    adc_digi_pattern_config_t patron[MAX_PINES];
+    memset(patron, 0, sizeof(patron));
+    uint32_t mascara = 0;
+    for (int i = 0; i < cantidad; i++) {
+        int canal = canalDePin(pines[i]);
+        if (canal < 0) return false;
+        mascara |= 1UL << canal;
+        patron[i].atten = ADC_ATTEN_DB_11; // 0-3,3 V
+        patron[i].channel = canal;
+        patron[i].unit = 0;                // ADC1
+        patron[i].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+    }
+
+    adc_digi_init_config_t inicio;
+    memset(&inicio, 0, sizeof(inicio));
+    inicio.max_store_buf_size = 4 * BYTES_POR_BLOQUE;
+    inicio.conv_num_each_intr = BYTES_POR_BLOQUE;
+    inicio.adc1_chan_mask = mascara;
+    inicio.adc2_chan_mask = 0;
+    if (adc_digi_initialize(&inicio) != ESP_OK) return false;
+
+    adc_digi_configuration_t config;
+    memset(&config, 0, sizeof(config));
+    config.conv_limit_en = 1; // Obligatorio en el ESP32
+    config.conv_limit_num = 250;
+    config.pattern_num = cantidad;
+    config.adc_pattern = patron;
+    config.sample_freq_hz = FRECUENCIA_HZ;
+    config.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+    config.format = ADC_DIGI_OUTPUT_FORMAT_TYPE1;
+    if (adc_digi_controller_configure(&config) != ESP_OK) {
+        adc_digi_deinitialize();
+        return false;
+    }
+
+    // Calibración de fábrica (eFuse Vref o Two Point); sin ella, 1100 mV nominal
+    esp_adc_cal_characterize(ADC_UNIT_1, ADC_ATTEN_DB_11, ADC_WIDTH_BIT_12, 1100, &calibracion);
+    mv_fondo_escala = esp_adc_cal_raw_to_voltage(4095, &calibracion);
+
+    if (adc_digi_start() != ESP_OK) {
+        adc_digi_deinitialize();
+        return false;
+    }
+    // Baja prioridad en el Core 0, junto al WiFi y el dibujo: la lógica (Core 1) no la nota
+    xTaskCreatePinnedToCore(tarea, "ADC", 2048, NULL, 1, NULL, 0);
+    canales_activos = mascara;
+    activo = true;
+    return true;
+}
+
+bool AdcContinuo::muestrea(int pin) {
+    int canal = canalDePin(pin);
+    return activo && canal >= 0 && (canales_activos & (1UL << canal));
+}
+
+bool AdcContinuo::leer(int pin, int &valor) {
+    int canal = canalDePin(pin);
+    if (!activo || canal < 0) return false;
+    int16_t v = valores[canal];
+    if (v < 0) return false;
+    valor = v;
+    return true;
+}
+
+void AdcContinuo::tarea(void *parametro) {
+    static uint8_t bloque[BYTES_POR_BLOQUE];
+    for (;;) {
+        uint32_t leidos = 0;
+        esp_err_t r = adc_digi_read_bytes(bloque, BYTES_POR_BLOQUE, &leidos, ADC_MAX_DELAY);
+        if (r == ESP_ERR_INVALID_STATE) desbordes++; // Se perdieron datos viejos; los de ahora valen
+        else if (r != ESP_OK) continue;
+
+        // 1. Sobremuestreo: sumar todas las muestras del bloque por canal
+        uint32_t suma[CANALES] = {0};
+        uint16_t cuenta[CANALES] = {0};
+        for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= leidos; i += SOC_ADC_DIGI_RESULT_BYTES) {
+            const adc_digi_output_data_t *m = (const adc_digi_output_data_t *)&bloque[i];
+            uint32_t canal = m->type1.channel;
+            if (canal >= (uint32_t)CANALES) continue;
+            suma[canal] += m->type1.data;
+            cuenta[canal]++;
+        }
+
+        // 2. Promedio, calibración (mV) y vuelta a 0-4095 sobre el fondo de escala calibrado
+        for (int c = 0; c < CANALES; c++) {
+            if (cuenta[c] == 0) continue;
+            uint32_t crudo = (suma[c] + cuenta[c] / 2) / cuenta[c];
+            uint32_t mv = esp_adc_cal_raw_to_voltage(crudo, &calibracion);
+            uint32_t escalado = mv * 4095 / mv_fondo_escala;
+            valores[c] = (int16_t)(escalado > 4095 ? 4095 : escalado);
+        }
+        bloques++;
+    }
+}
@@ -0,0 +1,74 @@
+// src/Audio.cpp
+
+#include "Audio.h"
+#include "Hal.h"
+
+static const uint16_t DO5 = 523, MI5 = 659, SOL5 = 784, DO6 = 1047;
+
+// Rebotes y punto: los mismos tonos que antes sonaban con tone() desde la física
+static const Audio::Nota NOTAS_BORDE[] = { {880, 50} };                // Agudo y corto
+static const Audio::Nota NOTAS_PALETA[] = { {440, 50} };               // Medio y corto
+static const Audio::Nota NOTAS_PUNTO[] = { {100, 200} };               // Grave y largo
+static const Audio::Nota NOTAS_FIN_PARTIDA[] = {
+    {DO5, 120}, {MI5, 120}, {SOL5, 120}, {0, 60}, {DO6, 300}
+};
+
+#define MELODIA(notas) { notas, (uint8_t)(sizeof(notas) / sizeof(notas[0])) }
+const Audio::Melodia Audio::MELODIAS[Audio::NUM_EVENTOS] = {
+    MELODIA(NOTAS_BORDE),
+    MELODIA(NOTAS_PALETA),
+    MELODIA(NOTAS_PUNTO),
+    MELODIA(NOTAS_FIN_PARTIDA)
+};
+#undef MELODIA
+
+Audio::Audio(int pin_buzzer)
+    : pin(pin_buzzer),
+      actual(NULL),
+      nota(0),
+      fin_nota_ms(0),
+      tocados(0)
+{
+}
+
+void Audio::empezarNota(uint32_t ahora_ms) {
+    const Nota &n = actual->notas[nota];
+    if (n.freq > 0) {
+        hal::tono(pin, n.freq);
+    } else {
+        hal::silencio(pin);
+    }
+    fin_nota_ms = ahora_ms + n.ms;
+}
+
+uint32_t Audio::procesar(uint32_t ahora_ms) {
+    // 1. Un evento nuevo corta lo que suene (solo cuenta el último de la cola)
+    uint8_t e;
+    bool hay_nuevo = false;
+    uint8_t ultimo = 0;
+    while (cola.sacar(e)) {
+        if (e < NUM_EVENTOS) {
+            ultimo = e;
+            hay_nuevo = true;
+        }
+    }
+    if (hay_nuevo) {
+        actual = &MELODIAS[ultimo];
+        nota = 0;
+        tocados++;
+        empezarNota(ahora_ms);
+    }
+
+    if (actual == NULL) return SIN_ESPERA;
+
+    // 2. Siguiente nota (o silencio al terminar la melodía)
+    while ((int32_t)(ahora_ms - fin_nota_ms) >= 0) {
+        if (++nota >= actual->cantidad) {
+            hal::silencio(pin);
+            actual = NULL;
+            return SIN_ESPERA;
+        }
+        empezarNota(fin_nota_ms); // Sin deriva aunque la tarea despierte tarde
+    }
+    return fin_nota_ms - ahora_ms;
+}
@@ -0,0 +1,67 @@
+// src/Audio.h
+//
+// --- SONIDO POR EVENTOS (secuenciador no bloqueante) ---
+// La física solo publica eventos (rebote en borde, golpe de paleta, punto,
+// fin de partida) en una ColaSPSC: meter() nunca espera ni llama al buzzer.
+// Task_Audio (main.cpp) los saca y toca su melodía nota por nota con
+// hal::tono() / hal::silencio() (LEDC en ESP32). Un evento nuevo corta la
+// melodía en curso, así el sonido acompaña a lo que se ve en pantalla.
+
+#ifndef AUDIO_H
+#define AUDIO_H
+
+#include <stdint.h>
+#include "ColaSPSC.h"
+
+class Audio {
+public:
+    enum Evento : uint8_t {
+        EVENTO_BORDE,
+        EVENTO_PALETA,
+        EVENTO_PUNTO,
+        EVENTO_FIN_PARTIDA,
+        NUM_EVENTOS
+    };
+
+    // Melodía de cada evento (tabla en Audio.cpp)
+    struct Nota {
+        uint16_t freq; // 0 = silencio
+        uint16_t ms;
+    };
+    struct Melodia {
+        const Nota *notas;
+        uint8_t cantidad;
+    };
+
+    // Sin nada sonando, procesar() devuelve esto: esperar al próximo evento
+    static const uint32_t SIN_ESPERA = 0xFFFFFFFFUL;
+
+    explicit Audio(int pin);
+
+    // --- Productor (tarea de lógica) ---
+    void publicar(Evento e) { cola.meter((uint8_t)e); }
+    // Hay eventos sin tocar (para despertar a Task_Audio)
+    bool hayEventos() const { return !cola.vacia(); }
+
+    // --- Consumidor (Task_Audio) ---
+    // Avanza la secuencia y devuelve los ms hasta la próxima nota, o SIN_ESPERA
+    uint32_t procesar(uint32_t ahora_ms);
+
+    // Estadísticas
+    uint32_t eventosTocados() const { return tocados; }
+    uint32_t eventosDescartados() const { return cola.descartadosTotales(); }
+
+private:
+    static const Melodia MELODIAS[NUM_EVENTOS];
+
+    void empezarNota(uint32_t ahora_ms);
+
+    int pin;
+    ColaSPSC<uint8_t, 16> cola;
+    const Melodia *actual; // NULL = en silencio
+    uint8_t nota;
+    uint32_t fin_nota_ms;
+    uint32_t tocados;
+};
+
+#endif // AUDIO_H
@@ -0,0 +1,157 @@
+// src/Benchmark.cpp
+
+#include "Benchmark.h"
+#include <stdlib.h>
+
+// Semilla fija: cada caso parte de la misma pelota en cada ejecución
+static const uint32_t SEMILLA_BENCH = 0xBEEF;
+static const int CALENTAMIENTO = 64;
+static const int MUESTRAS = 1000;
+// Llamadas por muestra para funciones muy cortas (amortiza la lectura del contador)
+static const int LOTE = 16;
+
+static uint32_t muestras[MUESTRAS];
+static uint32_t sobrecosto_medicion = 0;
+static int lote_actual = 1;
+
+// Mide MUESTRAS lotes de 'lote' llamadas a 'cuerpo'. Cada muestra guarda los
+// ciclos del lote completo menos el costo de leer el contador.
+template <typename F>
+static void medir(int lote, F cuerpo) {
+    for (int i = 0; i < CALENTAMIENTO; i++) cuerpo();
+
+    for (int i = 0; i < MUESTRAS; i++) {
+        uint32_t t0 = hal::contadorCiclos();
+        for (int j = 0; j < lote; j++) cuerpo();
+        uint32_t dt = hal::contadorCiclos() - t0;
+        muestras[i] = (dt > sobrecosto_medicion) ? dt - sobrecosto_medicion : 0;
+    }
+    lote_actual = lote;
+}
+
+static int compararU32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void calibrarSobrecosto() {
+    sobrecosto_medicion = 0;
+    medir(1, []() {});
+    qsort(muestras, MUESTRAS, sizeof(uint32_t), compararU32);
+    sobrecosto_medicion = muestras[0]; // El mínimo: costo puro de las dos lecturas
+}
+
+void Benchmark::reportar(const char *nombre, uint32_t *m, int n) {
+    qsort(m, n, sizeof(uint32_t), compararU32);
+
+    uint64_t suma = 0;
+    for (int i = 0; i < n; i++) suma += m[i];
+
+    const float lote = (float)lote_actual;
+    const float ns_por_ciclo = 1e9f / (float)hal::ciclosPorSegundo();
+    float p50 = m[n * 50 / 100] / lote;
+    float p90 = m[n * 90 / 100] / lote;
+    float p99 = m[n * 99 / 100] / lote;
+    float max = m[n - 1] / lote;
+    float media = (float)suma / (float)n / lote;
+
+    hal::logf("%-34s %9.1f %9.1f %9.1f %9.1f %9.1f | %9.1f %9.1f\n",
+              nombre, p50, p90, p99, max, media, p50 * ns_por_ciclo, p99 * ns_por_ciclo);
+}
+
+void Benchmark::prepararPartida(Juego &juego, GameState_t modo) {
+    hal::semillaAleatoria(SEMILLA_BENCH);
+    juego.gameState = modo;
+    juego.last_active_state = modo;
+    juego.menuSelection = 0;
+    juego.eligiendoDificultad = false;
+    juego.dificultadIA = 1;
+    juego.score_p1 = 0;
+    juego.score_p2 = 0;
+    juego.remote_control_active = false;
+    juego.remote_control_active_j2 = false;
+    juego.last_activity_time = hal::millis();
+    juego.pelota.reiniciar();
+    juego.paleta1.y = (64 / 2) - (juego.paleta1.ALTO / 2);
+    juego.paleta1.y_precisa = juego.paleta1.y;
+    juego.paleta2.y = juego.paleta1.y;
+    juego.paleta2.y_precisa = juego.paleta1.y_precisa;
+}
+
+void Benchmark::ejecutarTodos(Juego &juego) {
+    calibrarSobrecosto();
+
+    hal::logf("\n--- BENCHMARK DEL TICK DE LOGICA (%u muestras, contador a %u MHz) ---\n",
+              (unsigned)MUESTRAS, (unsigned)(hal::ciclosPorSegundo() / 1000000UL));
+    hal::logf("Sobrecosto de medicion descontado: %u ciclos\n", (unsigned)sobrecosto_medicion);
+    hal::logf("%-34s %9s %9s %9s %9s %9s | %9s %9s\n",
+              "caso (ciclos por llamada)", "p50", "p90", "p99", "max", "media", "ns p50", "ns p99");
+
+    Paleta &p1 = juego.paleta1;
+    Paleta &p2 = juego.paleta2;
+    Pelota &pelota = juego.pelota;
+
+    // 1. Movimiento + colisiones + puntuación de la pelota
+    prepararPartida(juego, STATE_VS_AI);
+    int s1 = 0, s2 = 0;
+    medir(LOTE, [&]() { pelota.actualizar(p1, p2, s1, s2); });
+    reportar("Pelota::actualizar", muestras, MUESTRAS);
+
+    // 2a. Barrido contra paletas, caso común: pelota en el centro (descarte rápido)
+    prepararPartida(juego, STATE_VS_AI);
+    Pelota::Impacto imp;
+    medir(LOTE, [&]() {
+        imp.tipo = Pelota::IMPACTO_NINGUNO;
+        imp.t = 1;
+        pelota.verificarColisionPaleta(p1, p2, 1, imp);
+    });
+    reportar("Pelota::verificarColisionPaleta", muestras, MUESTRAS);
+
+    // 2b. Barrido contra paletas, con impacto en la paleta 1 (cálculo del instante exacto)
+    prepararPartida(juego, STATE_VS_AI);
+    pelota.x = p1.x + p1.ANCHO + 1;
+    pelota.y = p1.y + 2;
+    pelota.velocidad_x = escalarDe(-2.0);
+    medir(LOTE, [&]() {
+        imp.tipo = Pelota::IMPACTO_NINGUNO;
+        imp.t = 1;
+        pelota.verificarColisionPaleta(p1, p2, 1, imp);
+    });
+    reportar("  ... con impacto", muestras, MUESTRAS);
+
+    // 3. Suavizado de la paleta con una entrada de joystick variable
+    prepararPartida(juego, STATE_VS_PLAYER);
+    unsigned k = 0;
+    medir(LOTE, [&]() { p1.actualizarPosicion((int)((k++ * 521u) & 4095u)); });
+    reportar("Paleta::actualizarPosicion", muestras, MUESTRAS);
+
+    // 4. IA de la paleta 2 (dificultad NORMAL)
+    prepararPartida(juego, STATE_VS_AI);
+    medir(LOTE, [&]() {
+        juego.logica_IA();
+        pelota.y = (int)((k++ * 7u) % 61u);
+    });
+    reportar("Juego::logica_IA", muestras, MUESTRAS);
+
+    // 5. Lectura de botones (sin pulsaciones)
+    prepararPartida(juego, STATE_VS_AI);
+    medir(LOTE, [&]() { juego.checkInput(); });
+    reportar("Juego::checkInput", muestras, MUESTRAS);
+
+    // 6. Un tick completo en partida VS MAQUINA (sin llegar a GAME OVER ni a IDLE)
+    prepararPartida(juego, STATE_VS_AI);
+    medir(1, [&]() {
+        juego.score_p1 = 0;
+        juego.score_p2 = 0;
+        juego.last_activity_time = hal::millis();
+        juego.actualizarLogica();
+    });
+    reportar("Juego::actualizarLogica (VS_AI)", muestras, MUESTRAS);
+
+    // Presupuesto del tick: un paso de PINGPONG_TICK_HZ
+    uint32_t presupuesto = (uint32_t)((uint64_t)hal::ciclosPorSegundo() * PRESUPUESTO_LOGICA_US / 1000000UL);
+    hal::logf("Tick p99: %.3f%% del presupuesto de %.2f ms a %u Hz (%u ciclos)\n",
+              100.0f * (float)muestras[MUESTRAS * 99 / 100] / (float)presupuesto,
+              PRESUPUESTO_LOGICA_US / 1000.0f, (unsigned)PINGPONG_TICK_HZ, (unsigned)presupuesto);
+}
@@ -0,0 +1,26 @@
+// src/Benchmark.h
+//
+// --- MICROBENCHMARKS DEL CAMINO CALIENTE (un tick de Task_LogicaJuego) ---
+// Se compila en todos los entornos pero solo se ejecuta con PINGPONG_BENCH:
+//   pio run -e native_bench -t exec          (PC, tiempos en ns)
+//   pio run -e featheresp32_bench -t upload  (ESP32, ciclos de CCOUNT)
+// Cada caso parte del mismo estado y semilla, así los resultados son
+// comparables entre ejecuciones.
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "Juego.h"
+
+class Benchmark {
+public:
+    // Ejecuta todos los casos sobre 'juego' e imprime la tabla por la HAL.
+    // Deja el juego en un estado de partida arbitrario.
+    static void ejecutarTodos(Juego &juego);
+
+private:
+    static void prepararPartida(Juego &juego, GameState_t modo);
+    static void reportar(const char *nombre, uint32_t *muestras, int n);
+};
+
+#endif // BENCHMARK_H
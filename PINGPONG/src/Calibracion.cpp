@@ -0,0 +1,95 @@
+// src/Calibracion.cpp
+
+#include "Calibracion.h"
+#include "Registro.h"
+
+// Formato del bloque guardado en NVS; cambiarla descarta las calibraciones viejas
+static const char *CLAVE_NVS = "calibracion";
+static const uint16_t VERSION_NVS = 1;
+
+struct DatosGuardados {
+    uint16_t version;
+    PuntosEje puntos[Calibracion::NUM_EJES];
+};
+
+static const char *NOMBRES_EJE[Calibracion::NUM_EJES] = {
+    "joystick J1", "joystick J2", "mando J1", "mando J2"
+};
+
+// --- EjeCalibrado ---
+EjeCalibrado::EjeCalibrado() {
+    const PuntosEje fabrica = { 0, EJE_CENTRO, EJE_MAXIMO };
+    construir(fabrica);
+}
+
+bool EjeCalibrado::construir(const PuntosEje &p) {
+    if (p.centro - p.minimo < EJE_RECORRIDO_MINIMO || p.maximo - p.centro < EJE_RECORRIDO_MINIMO) {
+        return false;
+    }
+    medidos = p;
+
+    for (int i = 0; i < ENTRADAS; i++) {
+        // Cada entrada vale lo que su valor crudo central
+        int crudo = (i << DESPLAZAMIENTO) + (1 << (DESPLAZAMIENTO - 1));
+
+        // Dos tramos lineales: mínimo..centro -> 0..2048, centro..máximo -> 2048..4095
+        int v;
+        if (crudo <= p.centro) {
+            v = EJE_CENTRO - (p.centro - crudo) * EJE_CENTRO / (p.centro - p.minimo);
+        } else {
+            v = EJE_CENTRO + (crudo - p.centro) * (EJE_MAXIMO - EJE_CENTRO) / (p.maximo - p.centro);
+        }
+        tabla[i] = (uint16_t)hal::limitar(v, 0, EJE_MAXIMO);
+    }
+    return true;
+}
+
+// --- Calibracion ---
+Calibracion::Calibracion() : activo(false) {
+    for (int e = 0; e < NUM_EJES; e++) registro[e].visto = false;
+}
+
+bool Calibracion::cargar() {
+    DatosGuardados d;
+    if (!hal::leerPersistente(CLAVE_NVS, &d, sizeof(d)) || d.version != VERSION_NVS) return false;
+    for (int e = 0; e < NUM_EJES; e++) ejes[e].construir(d.puntos[e]);
+    return true;
+}
+
+void Calibracion::empezar() {
+    for (int e = 0; e < NUM_EJES; e++) registro[e].visto = false;
+    activo = true;
+}
+
+int Calibracion::terminar() {
+    activo = false;
+    int cambiados = 0;
+    for (int e = 0; e < NUM_EJES; e++) {
+        const Registro &r = registro[e];
+        if (!r.visto) continue;
+        PuntosEje p = { (int16_t)r.minimo, (int16_t)r.ultimo, (int16_t)r.maximo };
+        if (ejes[e].construir(p)) {
+            cambiados++;
+        } else {
+            REGISTRO_AVISO("[calibracion] %s: recorrido insuficiente (%d / %d / %d), se conserva el anterior",
+                           NOMBRES_EJE[e], r.minimo, r.ultimo, r.maximo);
+        }
+    }
+    if (cambiados == 0) return 0;
+
+    DatosGuardados d;
+    d.version = VERSION_NVS;
+    for (int e = 0; e < NUM_EJES; e++) d.puntos[e] = ejes[e].puntos();
+    if (!hal::guardarPersistente(CLAVE_NVS, &d, sizeof(d))) {
+        REGISTRO_ERROR("[calibracion] no se pudo guardar en NVS (vale hasta el próximo reinicio)");
+    }
+    return cambiados;
+}
+
+void Calibracion::imprimir() const {
+    for (int e = 0; e < NUM_EJES; e++) {
+        const PuntosEje &p = ejes[e].puntos();
+        REGISTRO_INFO("[calibracion] %-11s min %4d | centro %4d | max %4d",
+                      NOMBRES_EJE[e], p.minimo, p.centro, p.maximo);
+    }
+}
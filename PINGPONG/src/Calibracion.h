@@ -0,0 +1,124 @@
+// src/Calibracion.h
+//
+// --- CALIBRACIÓN DE LOS EJES (joysticks locales y mandos remotos) ---
+// El ADC del ESP32 no es lineal y cada joystick tiene su propio centro y
+// recorrido. En el modo calibración se registran mínimo, centro y máximo de
+// cada eje y con ellos se arma una tabla de 256 entradas que lleva la lectura
+// cruda (0-4095) a la escala lineal del juego, con el centro en 2048. Después
+// recortar() aplasta la zona muerta al centro y satura los extremos. El
+// predictor del mando remoto recibe el valor lineal (la zona muerta le
+// inventaría saltos de velocidad) y el recorte se aplica a lo que estima. Los
+// umbrales del juego (menú, actividad) se definen una sola vez sobre esa escala.
+// Se guardan en NVS los tres puntos de cada eje (no las tablas): así un cambio
+// de la tabla no invalida una calibración ya hecha. Sin datos guardados, cada
+// eje usa la calibración de fábrica (0 / 2048 / 4095), que equivale a los
+// umbrales fijos de antes.
+
+#ifndef CALIBRACION_H
+#define CALIBRACION_H
+
+#include <stdint.h>
+#include "Hal.h"
+
+// Los tres puntos medidos de un eje, en unidades crudas (0-4095)
+struct PuntosEje {
+    int16_t minimo;
+    int16_t centro;
+    int16_t maximo;
+};
+
+// --- Escala normalizada del eje (después de la tabla) ---
+const int EJE_CENTRO = 2048;
+const int EJE_MAXIMO = 4095;
+const int EJE_ZONA_MUERTA = 300;     // Más cerca del centro que esto -> EJE_CENTRO
+const int EJE_MARGEN_EXTREMO = 50;   // Más cerca de un tope que esto -> el tope
+const int EJE_UMBRAL_MENU_SUBE = 548; // Desvío que mueve la selección hacia arriba (< 1500)
+const int EJE_UMBRAL_MENU_BAJA = 452; // Y hacia abajo (> 2500)
+const int EJE_UMBRAL_ACTIVIDAD = 500; // Desvío que cuenta como actividad (ahorro de energía)
+const int EJE_RECORRIDO_MINIMO = 400; // Recorrido crudo mínimo a cada lado del centro al calibrar
+
+class EjeCalibrado {
+public:
+    static const int BITS_INDICE = 8;
+    static const int ENTRADAS = 1 << BITS_INDICE;
+    static const int DESPLAZAMIENTO = 12 - BITS_INDICE; // Cada entrada cubre 16 valores crudos
+
+    EjeCalibrado();
+
+    // Rearma la tabla; false (y no cambia nada) si los puntos no dejan
+    // suficiente recorrido a cada lado del centro
+    bool construir(const PuntosEje &p);
+
+    // Lectura cruda (0-4095) -> escala lineal. Una sola consulta.
+    int linealizar(int crudo) const {
+        return tabla[(uint32_t)hal::limitar(crudo, 0, EJE_MAXIMO) >> DESPLAZAMIENTO];
+    }
+
+    // Zona muerta y saturación de los extremos sobre la escala lineal
+    static int recortar(int v) {
+        if (v > EJE_CENTRO - EJE_ZONA_MUERTA && v < EJE_CENTRO + EJE_ZONA_MUERTA) return EJE_CENTRO;
+        if (v < EJE_MARGEN_EXTREMO) return 0;
+        if (v > EJE_MAXIMO - EJE_MARGEN_EXTREMO) return EJE_MAXIMO;
+        return v;
+    }
+
+    int aplicar(int crudo) const { return recortar(linealizar(crudo)); }
+
+    const PuntosEje &puntos() const { return medidos; }
+
+private:
+    uint16_t tabla[ENTRADAS];
+    PuntosEje medidos;
+};
+
+class Calibracion {
+public:
+    enum Eje {
+        LOCAL_J1,
+        LOCAL_J2,
+        REMOTO_J1,
+        REMOTO_J2,
+        NUM_EJES
+    };
+
+    Calibracion();
+
+    int aplicar(Eje eje, int crudo) const { return ejes[eje].aplicar(crudo); }
+    int linealizar(Eje eje, int crudo) const { return ejes[eje].linealizar(crudo); }
+
+    // Lee los puntos guardados en NVS; false si no hay (quedan los de fábrica)
+    bool cargar();
+
+    // --- Modo calibración (solo la tarea de lógica) ---
+    // Olvida lo registrado y empieza a mirar las lecturas crudas
+    void empezar();
+    bool grabando() const { return activo; }
+    void observar(Eje eje, int crudo) {
+        Registro &r = registro[eje];
+        if (!r.visto || crudo < r.minimo) r.minimo = crudo;
+        if (!r.visto || crudo > r.maximo) r.maximo = crudo;
+        r.ultimo = crudo;
+        r.visto = true;
+    }
+    // La última lectura de cada eje pasa a ser su centro. Rearma las tablas de
+    // los ejes que se movieron lo suficiente (los demás, p. ej. un mando
+    // apagado, conservan la calibración anterior), las guarda en NVS y
+    // devuelve cuántos ejes cambiaron.
+    int terminar();
+
+    void imprimir() const;
+
+private:
+    struct Registro {
+        bool visto;
+        int minimo;
+        int maximo;
+        int ultimo;
+    };
+
+    EjeCalibrado ejes[NUM_EJES];
+    Registro registro[NUM_EJES];
+    bool activo;
+};
+
+#endif // CALIBRACION_H
@@ -0,0 +1,81 @@
+// src/ColaMPSC.h
+//
+// --- COLA CIRCULAR SIN CERROJOS (varios productores, un consumidor) ---
+// Capacidad fija N (potencia de 2). Cada celda lleva un número de secuencia
+// que dice si está libre para la vuelta actual o ya tiene un dato: los
+// productores se reparten las celdas con un compare-exchange sobre 'cabeza' y
+// ninguno espera a otro ni al consumidor. Si la cola está llena, meter() falla
+// y el dato se cuenta en 'descartados'.
+// Si un productor es desalojado entre reservar su celda y publicarla, el
+// consumidor no avanza más allá de ella hasta que la publique (los demás
+// productores siguen). Sirve para el registro (Registro.h), no para ISR.
+
+#ifndef COLA_MPSC_H
+#define COLA_MPSC_H
+
+#include <stdint.h>
+#include <atomic>
+
+template <typename T, uint32_t N>
+class ColaMPSC {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "N debe ser potencia de 2");
+
+public:
+    ColaMPSC() : cabeza(0), cola(0), descartados(0) {
+        for (uint32_t i = 0; i < N; i++) celdas[i].secuencia.store(i, std::memory_order_relaxed);
+    }
+
+    // --- Productores (cualquier tarea) ---
+    bool meter(const T &dato) {
+        uint32_t pos = cabeza.load(std::memory_order_relaxed);
+        for (;;) {
+            Celda &c = celdas[pos & (N - 1)];
+            int32_t dif = (int32_t)(c.secuencia.load(std::memory_order_acquire) - pos);
+            if (dif == 0) {
+                // Celda libre en esta vuelta: reservarla
+                if (cabeza.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    c.dato = dato;
+                    c.secuencia.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (dif < 0) {
+                // El consumidor aún no liberó la celda de la vuelta anterior: llena
+                descartados.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                pos = cabeza.load(std::memory_order_relaxed); // Otro productor la tomó
+            }
+        }
+    }
+
+    // --- Consumidor ---
+    bool sacar(T &dato) {
+        uint32_t pos = cola.load(std::memory_order_relaxed);
+        Celda &c = celdas[pos & (N - 1)];
+        if (c.secuencia.load(std::memory_order_acquire) != pos + 1) return false;
+        dato = c.dato;
+        c.secuencia.store(pos + N, std::memory_order_release); // Libre para la próxima vuelta
+        cola.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Aproximado desde los productores
+    bool vacia() const {
+        return cola.load(std::memory_order_acquire) == cabeza.load(std::memory_order_acquire);
+    }
+
+    uint32_t descartadosTotales() const { return descartados.load(std::memory_order_relaxed); }
+
+private:
+    struct Celda {
+        std::atomic<uint32_t> secuencia;
+        T dato;
+    };
+
+    Celda celdas[N];
+    std::atomic<uint32_t> cabeza; // Próxima celda a reservar (productores)
+    std::atomic<uint32_t> cola;   // Próxima celda a leer (solo el consumidor)
+    std::atomic<uint32_t> descartados;
+};
+
+#endif // COLA_MPSC_H
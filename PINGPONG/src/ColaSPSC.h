@@ -0,0 +1,57 @@
+// src/ColaSPSC.h
+//
+// --- COLA CIRCULAR SIN CERROJOS (un productor, un consumidor) ---
+// Capacidad fija N (potencia de 2). El productor solo escribe 'cabeza' y el
+// consumidor solo escribe 'cola', así que ninguno espera al otro: sirve para
+// pasar datos del callback de ESP-NOW (tarea WiFi) a la tarea de lógica.
+// Si la cola está llena, meter() falla y el dato se cuenta en 'descartados'.
+
+#ifndef COLA_SPSC_H
+#define COLA_SPSC_H
+
+#include <stdint.h>
+#include <atomic>
+
+template <typename T, uint32_t N>
+class ColaSPSC {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "N debe ser potencia de 2");
+
+public:
+    ColaSPSC() : cabeza(0), cola(0), descartados(0) {}
+
+    // --- Productor ---
+    bool meter(const T &dato) {
+        uint32_t c = cabeza.load(std::memory_order_relaxed);
+        if (c - cola.load(std::memory_order_acquire) == N) {
+            descartados.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        datos[c & (N - 1)] = dato;
+        cabeza.store(c + 1, std::memory_order_release);
+        return true;
+    }
+
+    // --- Consumidor ---
+    bool sacar(T &dato) {
+        uint32_t t = cola.load(std::memory_order_relaxed);
+        if (t == cabeza.load(std::memory_order_acquire)) return false;
+        dato = datos[t & (N - 1)];
+        cola.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Aproximado si se llama desde la otra tarea (sirve para decidir si despertarla)
+    bool vacia() const {
+        return cola.load(std::memory_order_acquire) == cabeza.load(std::memory_order_acquire);
+    }
+
+    uint32_t descartadosTotales() const { return descartados.load(std::memory_order_relaxed); }
+
+private:
+    T datos[N];
+    std::atomic<uint32_t> cabeza; // Próxima posición a escribir (solo el productor)
+    std::atomic<uint32_t> cola;   // Próxima posición a leer (solo el consumidor)
+    std::atomic<uint32_t> descartados;
+};
+
+#endif // COLA_SPSC_H
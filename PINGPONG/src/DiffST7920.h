@@ -0,0 +1,89 @@
+// src/DiffST7920.h
+//
+// --- ENVÍO INCREMENTAL DEL FRAMEBUFFER AL ST7920 ---
+// Guarda una copia del último frame enviado a la GDRAM y, en cada frame nuevo,
+// solo entrega los tramos de fila que cambiaron. La GDRAM del ST7920 se
+// direcciona en palabras de 16 píxeles, así que cada tramo va desde la primera
+// hasta la última palabra modificada de la fila.
+// Formato del frame: 64 filas x 16 bytes, MSB = píxel de la izquierda
+// (el mismo que usa U8g2 en modo de buffer completo para el ST7920).
+
+#ifndef DIFF_ST7920_H
+#define DIFF_ST7920_H
+
+#include <stdint.h>
+#include <string.h>
+
+class DiffST7920 {
+public:
+    static const int FILAS = 64;
+    static const int BYTES_POR_FILA = 16;
+    static const int BYTES_FRAME = FILAS * BYTES_POR_FILA;
+
+    struct Tramo {
+        uint8_t fila;         // 0-63
+        uint8_t palabra;      // Primera palabra de 16 px (0-7)
+        uint8_t bytes;        // Bytes a enviar (múltiplo de 2)
+        const uint8_t *datos; // Apunta dentro del frame nuevo
+    };
+
+    DiffST7920() { invalidar(); }
+
+    // Olvida lo enviado: el próximo frame se manda completo
+    void invalidar() { valida = false; }
+
+    // Llama a enviar(const Tramo &) por cada tramo cambiado y actualiza la copia.
+    // Devuelve el número de filas enviadas.
+    template <typename F>
+    int enviarCambios(const uint8_t *frame, F enviar) {
+        int filas = 0;
+        uint32_t bytes = 0;
+
+        for (int f = 0; f < FILAS; f++) {
+            const uint8_t *nueva = frame + f * BYTES_POR_FILA;
+            uint8_t *vieja = sombra + f * BYTES_POR_FILA;
+
+            int primera = 0;
+            int ultima = BYTES_POR_FILA - 1;
+            if (valida) {
+                while (primera < BYTES_POR_FILA && nueva[primera] == vieja[primera]) primera++;
+                if (primera == BYTES_POR_FILA) continue; // Fila sin cambios
+                while (nueva[ultima] == vieja[ultima]) ultima--;
+            }
+
+            // Alinear a palabras de 16 bits (2 bytes)
+            primera &= ~1;
+            ultima |= 1;
+
+            Tramo t;
+            t.fila = (uint8_t)f;
+            t.palabra = (uint8_t)(primera / 2);
+            t.bytes = (uint8_t)(ultima - primera + 1);
+            t.datos = nueva + primera;
+            enviar(t);
+
+            memcpy(vieja + primera, nueva + primera, t.bytes);
+            filas++;
+            bytes += t.bytes;
+        }
+
+        valida = true;
+        filas_ultimo_frame = filas;
+        bytes_ultimo_frame = bytes;
+        frames++;
+        bytes_totales += bytes;
+        return filas;
+    }
+
+    // Estadísticas
+    int filas_ultimo_frame = 0;
+    uint32_t bytes_ultimo_frame = 0;
+    uint32_t frames = 0;
+    uint64_t bytes_totales = 0;
+
+private:
+    uint8_t sombra[BYTES_FRAME];
+    bool valida;
+};
+
+#endif // DIFF_ST7920_H
@@ -0,0 +1,95 @@
+// src/Fijo.h
+//
+// --- ARITMÉTICA DE PUNTO FIJO Q16.16 PARA LA FÍSICA ---
+// La pelota y las paletas usan el tipo 'Escalar'. Con PINGPONG_FISICA_FIJA=1
+// (por defecto) es un Q16.16 de enteros: sin FPU en ningún núcleo y con
+// resultados idénticos bit a bit en el ESP32 y en el PC, así una simulación
+// nativa con la misma semilla (hal::semillaAleatoria, main.cpp la informa al
+// arrancar) y las mismas entradas reproduce exactamente la trayectoria del
+// dispositivo.
+// Con -D PINGPONG_FISICA_FIJA=0 se vuelve a la física con float.
+
+#ifndef FIJO_H
+#define FIJO_H
+
+#include <stdint.h>
+
+#ifndef PINGPONG_FISICA_FIJA
+#define PINGPONG_FISICA_FIJA 1
+#endif
+
+class Fijo {
+public:
+    static const int BITS_FRACCION = 16;
+    static const int32_t UNO = 1 << BITS_FRACCION;
+
+    int32_t raw;
+
+    constexpr Fijo() : raw(0) {}
+    // Conversión implícita desde entero (pixeles, límites de pantalla, etc.)
+    constexpr Fijo(int v) : raw(v * UNO) {}
+
+    static constexpr Fijo desdeRaw(int32_t r) { return Fijo(r, 0); }
+    // Solo para constantes: se evalúa en compilación, no toca la FPU en el tick
+    static constexpr Fijo desdeDouble(double v) {
+        return desdeRaw((int32_t)(v * UNO + (v >= 0 ? 0.5 : -0.5)));
+    }
+    static Fijo fraccion(int32_t num, int32_t den) {
+        return desdeRaw((int32_t)(((int64_t)num * UNO) / den));
+    }
+
+    // Parte entera redondeada hacia abajo
+    int entero() const { return raw >> BITS_FRACCION; }
+    explicit operator int() const { return entero(); }
+    float aFloat() const { return (float)raw / (float)UNO; }
+
+    Fijo operator-() const { return desdeRaw(-raw); }
+    Fijo &operator+=(Fijo o) { raw += o.raw; return *this; }
+    Fijo &operator-=(Fijo o) { raw -= o.raw; return *this; }
+
+    friend Fijo operator+(Fijo a, Fijo b) { return desdeRaw(a.raw + b.raw); }
+    friend Fijo operator-(Fijo a, Fijo b) { return desdeRaw(a.raw - b.raw); }
+    friend Fijo operator*(Fijo a, Fijo b) {
+        return desdeRaw((int32_t)(((int64_t)a.raw * b.raw) >> BITS_FRACCION));
+    }
+    friend Fijo operator/(Fijo a, Fijo b) {
+        return desdeRaw((int32_t)(((int64_t)a.raw * UNO) / b.raw));
+    }
+
+    friend bool operator<(Fijo a, Fijo b) { return a.raw < b.raw; }
+    friend bool operator>(Fijo a, Fijo b) { return a.raw > b.raw; }
+    friend bool operator<=(Fijo a, Fijo b) { return a.raw <= b.raw; }
+    friend bool operator>=(Fijo a, Fijo b) { return a.raw >= b.raw; }
+    friend bool operator==(Fijo a, Fijo b) { return a.raw == b.raw; }
+    friend bool operator!=(Fijo a, Fijo b) { return a.raw != b.raw; }
+
+private:
+    constexpr Fijo(int32_t r, int) : raw(r) {}
+};
+
+// --- TIPO ESCALAR DE LA FÍSICA ---
+// Funciones auxiliares con la misma firma en ambos modos, para que Pelota,
+// Paleta y la IA se escriban una sola vez.
+#if PINGPONG_FISICA_FIJA
+
+typedef Fijo Escalar;
+
+constexpr Escalar escalarDe(double v) { return Fijo::desdeDouble(v); }
+inline Escalar escalarFraccion(int32_t num, int32_t den) { return Fijo::fraccion(num, den); }
+inline int escalarAEntero(Escalar v) { return v.entero(); }
+inline float escalarAFloat(Escalar v) { return v.aFloat(); }
+inline Escalar valorAbsoluto(Escalar v) { return v.raw < 0 ? -v : v; }
+
+#else
+
+typedef float Escalar;
+
+constexpr Escalar escalarDe(double v) { return (float)v; }
+inline Escalar escalarFraccion(int32_t num, int32_t den) { return (float)num / (float)den; }
+inline int escalarAEntero(Escalar v) { return (int)v; }
+inline float escalarAFloat(Escalar v) { return v; }
+inline Escalar valorAbsoluto(Escalar v) { return v < 0 ? -v : v; }
+
+#endif
+
+#endif // FIJO_H
@@ -0,0 +1,24 @@
+// src/Hal.cpp
+// Partes de la HAL que no dependen de la plataforma: el mismo código se
+// compila en el ESP32 y en el PC.
+
+#include "Hal.h"
+
+namespace hal {
+
+// --- NÚMEROS ALEATORIOS ---
+// xorshift32 propio en vez de random() de Arduino: con la misma semilla el
+// ESP32 y la simulación nativa sacan la misma secuencia (y la misma pelota).
+static uint32_t estado_rng = 1;
+
+void semillaAleatoria(uint32_t semilla) { estado_rng = semilla ? semilla : 1; }
+
+long aleatorio(long min, long max) {
+    if (max <= min) return min;
+    estado_rng ^= estado_rng << 13;
+    estado_rng ^= estado_rng >> 17;
+    estado_rng ^= estado_rng << 5;
+    return min + (long)(estado_rng % (uint32_t)(max - min));
+}
+
+} // namespace hal
@@ -0,0 +1,188 @@
+// src/Hal.h
+//
+// --- CAPA DE ABSTRACCIÓN DE HARDWARE (HAL) ---
+// Juego, Pelota y Paleta solo hablan con el hardware a través de estas
+// funciones. Hay dos implementaciones:
+//   - Hal_esp32.cpp  : Arduino + U8g2 + FreeRTOS (env:featheresp32)
+//   - Hal_native.cpp : simulación en PC, reloj virtual (env:native)
+// El entorno nativo define PINGPONG_NATIVE en platformio.ini.
+
+#ifndef HAL_H
+#define HAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "DiffST7920.h"
+
+#ifdef PINGPONG_NATIVE
+#include <atomic>
+// En PC no existe la RAM RTC: la variable se comporta como una global normal.
+#define RTC_DATA_ATTR
+#else
+#include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+#endif
+
+namespace hal {
+
+// --- NIVELES LÓGICOS (sustituyen HIGH/LOW de Arduino) ---
+const int NIVEL_BAJO = 0;
+const int NIVEL_ALTO = 1;
+
+// --- RELOJ ---
+uint32_t millis();
+uint32_t micros();
+// Espera bloqueante cediendo la CPU (vTaskDelay en ESP32, avanza el reloj virtual en PC)
+void esperarMs(uint32_t ms);
+// Contador de alta resolución para medir rendimiento: CCOUNT en ESP32,
+// reloj monotónico real en PC (en ns). No usa el reloj virtual.
+uint32_t contadorCiclos();
+uint32_t ciclosPorSegundo();
+
+// --- ADC / GPIO ---
+void configurarEntrada(int pin);   // Entrada con pull-up
+void configurarSalida(int pin);
+int leerADC(int pin);              // 0-4095
+int leerGPIO(int pin);             // NIVEL_BAJO / NIVEL_ALTO
+
+// --- BOTONES (interrupción + antirrebote por temporizador) ---
+// Cada cambio de un pin registrado con configurarBoton() queda como evento con
+// su hora en una cola que vacía la tarea de lógica: una pulsación más corta
+// que un paso no se pierde y nadie lee los pines en cada paso.
+struct EventoBoton {
+    uint32_t marca_us;  // hal::micros() del flanco
+    uint8_t pin;
+    bool presionado;
+};
+void configurarBoton(int pin);          // Entrada con pull-up, activo en bajo
+bool sacarEventoBoton(EventoBoton &e);  // Solo la tarea de lógica
+// Espera hasta 'ms' o hasta el próximo evento de botón (tarea de lógica en IDLE)
+void esperarReposo(uint32_t ms);
+
+// --- BUZZER ---
+// Onda cuadrada continua hasta silencio() (LEDC en ESP32). La duración de cada
+// nota la lleva el secuenciador de Audio.h, nunca quien genera el evento.
+void tono(int pin, int freq);
+void silencio(int pin);
+
+// --- NÚMEROS ALEATORIOS ---
+// El mismo xorshift32 en las dos plataformas (Hal.cpp): una semilla da la
+// misma secuencia en el ESP32 y en el PC.
+void semillaAleatoria(uint32_t semilla);
+long aleatorio(long min, long max);  // [min, max)
+uint32_t semillaHardware();          // Fuente de entropía de la plataforma
+
+// --- CONSOLA (Serial en ESP32, stdout en PC) ---
+// Síncrona: quien escribe espera a la UART. Solo para informes pedidos por
+// serie y la salida del simulador; los mensajes de las tareas van por el
+// registro asíncrono (Registro.h).
+void log(const char *msg);
+void logf(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+
+// --- ALMACENAMIENTO PERSISTENTE ---
+// Bloques de bytes con nombre que sobreviven a reinicios y a cortes de
+// alimentación: NVS (Preferences) en ESP32, memoria del proceso en PC.
+// Escribir en flash tarda milisegundos: no llamarlo en medio de una partida.
+bool leerPersistente(const char *clave, void *datos, size_t len);  // false si no existe o cambió de tamaño
+bool guardarPersistente(const char *clave, const void *datos, size_t len);
+
+// --- ENERGÍA ---
+// Configura las fuentes de despertar (pines EXT1 en bajo y timer) y entra en
+// Deep Sleep. Solo regresa si la plataforma no pudo dormir.
+void dormirProfundo(uint64_t mascara_pines, uint32_t timeout_seg);
+
+// --- CERROJO ENTRE NÚCLEOS ---
+// portMUX (spinlock + sección crítica) en ESP32, spinlock atómico en PC.
+class Cerrojo {
+public:
+    inline void bloquear();
+    inline void desbloquear();
+private:
+#ifdef PINGPONG_NATIVE
+    std::atomic_flag bandera = ATOMIC_FLAG_INIT;
+#else
+    portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+#endif
+};
+
+#ifdef PINGPONG_NATIVE
+inline void Cerrojo::bloquear() { while (bandera.test_and_set(std::memory_order_acquire)) { } }
+inline void Cerrojo::desbloquear() { bandera.clear(std::memory_order_release); }
+#else
+inline void Cerrojo::bloquear() { portENTER_CRITICAL(&mux); }
+inline void Cerrojo::desbloquear() { portEXIT_CRITICAL(&mux); }
+#endif
+
+// --- PANTALLA ST7920 128x64 ---
+// Subconjunto de la API de U8g2 que usa el juego. Las fuentes se eligen con
+// un enum para que el código de dibujo no dependa de los datos de U8g2.
+// Modo de buffer completo: se dibuja una sola vez por frame (clearBuffer +
+// primitivas) y sendBuffer() envía solo las filas que cambiaron (DiffST7920).
+enum Fuente {
+    FUENTE_7X14B,
+    FUENTE_7X14,
+    FUENTE_6X10,
+    FUENTE_4X6
+};
+
+class Pantalla {
+public:
+    static const int ANCHO = 128;
+    static const int ALTO = 64;
+
+    void begin();
+    void setPowerSave(int activo);
+    void clearBuffer();
+    void sendBuffer();
+    void setDrawColor(int color);
+    void setFont(Fuente fuente);
+    void drawStr(int x, int y, const char *str);
+    void drawBox(int x, int y, int w, int h);
+    void drawVLine(int x, int y, int h);
+    void setCursor(int x, int y);
+    void print(const char *str);
+
+    // true si el último frame con cambios ya salió completo por el bus, y
+    // cuándo (hal::micros()). Con DMA es false mientras se sigue transmitiendo.
+    bool envioTerminado(uint32_t &fin_us) const;
+
+    // Último frame enviado y estadísticas de envío
+    DiffST7920 diff;
+    uint32_t fin_envio_us = 0; // Envíos bloqueantes: hal::micros() al terminar
+
+#ifdef PINGPONG_NATIVE
+    // Framebuffer horizontal (16 bytes por fila, MSB a la izquierda),
+    // mismo formato que la GDRAM del ST7920. Útil para inspeccionar frames.
+    uint8_t buffer[ANCHO * ALTO / 8];
+    bool apagada = false;
+private:
+    int cursor_x = 0;
+    int cursor_y = 0;
+    int color = 1;
+    void pixel(int x, int y);
+#endif
+};
+
+extern Pantalla pantalla;
+
+// --- UTILIDADES NUMÉRICAS (sustituyen constrain/map de Arduino) ---
+template <typename T>
+inline T limitar(T v, T bajo, T alto) {
+    return v < bajo ? bajo : (v > alto ? alto : v);
+}
+
+#ifdef PINGPONG_NATIVE
+// --- CONTROLES DEL SIMULADOR (solo PC) ---
+// El reloj es virtual: solo avanza con avanzarReloj() o esperarMs(), así una
+// simulación produce siempre el mismo resultado.
+namespace sim {
+void avanzarReloj(uint32_t us);
+void fijarADC(int pin, int valor);
+void fijarGPIO(int pin, int nivel);
+void silenciarLog(bool silenciar);
+} // namespace sim
+#endif
+
+} // namespace hal
+
+#endif // HAL_H
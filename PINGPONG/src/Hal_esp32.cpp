@@ -0,0 +1,315 @@
+// src/Hal_esp32.cpp
+// Implementación de la HAL sobre Arduino-ESP32 (U8g2, FreeRTOS, esp_sleep).
+
+#include "Hal.h"
+#include <U8g2lib.h>
+#include <Preferences.h>
+#include <stdarg.h>
+#include <string.h>
+#include "freertos/task.h"
+#include "freertos/timers.h"
+#include "esp_sleep.h"
+#include "TransporteST7920.h"
+#include "AdcContinuo.h"
+#include "Calibracion.h"
+#include "ColaSPSC.h"
+#include "Registro.h"
+
+// --- Handles de las tareas (definidos en main.cpp) ---
+extern TaskHandle_t xTaskLogicaJuegoHandle;
+extern TaskHandle_t xTaskDibujoHandle;
+
+// Objeto U8g2 real de la pantalla. Buffer completo (_F_): 1 KB en RAM, se dibuja una vez por frame.
+#ifdef PINGPONG_SPI_SOFTWARE
+// Bit-banging (Software SPI: clock=18, data=23, CS=5, reset=22)
+static U8G2_ST7920_128X64_F_SW_SPI u8g2(U8G2_R0, /* clock=*/ 18, /* data=*/ 23, /* CS=*/ 5, /* reset=*/ 22);
+#else
+// VSPI por hardware + DMA en los mismos pines (TransporteST7920.h)
+static U8G2_ST7920_128X64_F_DMA u8g2(U8G2_R0, /* reset=*/ 22);
+#endif
+
+namespace hal {
+
+Pantalla pantalla;
+
+// --- RELOJ ---
+uint32_t millis() { return ::millis(); }
+uint32_t micros() { return ::micros(); }
+void esperarMs(uint32_t ms) { vTaskDelay(pdMS_TO_TICKS(ms)); }
+uint32_t contadorCiclos() { return ESP.getCycleCount(); }
+uint32_t ciclosPorSegundo() { return getCpuFrequencyMhz() * 1000000UL; }
+
+// --- ADC / GPIO ---
+void configurarEntrada(int pin) { pinMode(pin, INPUT_PULLUP); }
+void configurarSalida(int pin) { pinMode(pin, OUTPUT); }
+int leerADC(int pin) {
+#if PINGPONG_ADC_CONTINUO
+    if (AdcContinuo::muestrea(pin)) {
+        // Ya filtrado y calibrado por la tarea del ADC; hasta su primer bloque, eje en reposo
+        int valor;
+        return AdcContinuo::leer(pin, valor) ? valor : EJE_CENTRO;
+    }
+#endif
+    return analogRead(pin); // Sin driver continuo (o no arrancó)
+}
+int leerGPIO(int pin) { return digitalRead(pin); }
+
+// --- BOTONES ---
+// El primer flanco se publica en la misma interrupción (la dirección es la
+// contraria al último estado publicado) y abre un bloqueo de ANTIRREBOTE_MS
+// en el que los rebotes se ignoran. Al vencer el temporizador se relee el
+// pin: si no coincide con lo publicado (se soltó durante el bloqueo, o el
+// flanco fue ruido) se publica la corrección y se bloquea otra vez.
+// La interrupción (Core 1) y el temporizador (tarea de temporizadores de
+// FreeRTOS) publican bajo el mismo spinlock: la cola sigue con un solo
+// productor a la vez.
+static const uint32_t ANTIRREBOTE_MS = 20;
+static const int MAX_BOTONES = 4;
+
+struct EstadoBoton {
+    int pin;
+    bool presionado;  // Último estado publicado
+    bool bloqueado;   // Dentro de la ventana de antirrebote
+    TimerHandle_t temporizador;
+};
+
+static EstadoBoton botones[MAX_BOTONES];
+static int num_botones = 0;
+static ColaSPSC<EventoBoton, 32> cola_botones;
+static portMUX_TYPE mux_botones = portMUX_INITIALIZER_UNLOCKED;
+static volatile bool logica_en_reposo = false; // La tarea de lógica espera en esperarReposo()
+
+// Con el spinlock tomado
+static void IRAM_ATTR publicarBoton(EstadoBoton &b, uint32_t marca_us) {
+    EventoBoton e;
+    e.marca_us = marca_us;
+    e.pin = (uint8_t)b.pin;
+    e.presionado = b.presionado;
+    cola_botones.meter(e);
+}
+
+static void IRAM_ATTR alFlancoBoton(void *arg) {
+    EstadoBoton &b = *(EstadoBoton *)arg;
+    uint32_t ahora_us = ::micros();
+    portENTER_CRITICAL_ISR(&mux_botones);
+    bool nuevo = !b.bloqueado;
+    if (nuevo) {
+        b.bloqueado = true;
+        b.presionado = !b.presionado;
+        publicarBoton(b, ahora_us);
+    }
+    portEXIT_CRITICAL_ISR(&mux_botones);
+    if (!nuevo) return; // Rebote: lo resuelve el temporizador
+
+    BaseType_t despertar = pdFALSE;
+    xTimerStartFromISR(b.temporizador, &despertar);
+    if (logica_en_reposo) vTaskNotifyGiveFromISR(xTaskLogicaJuegoHandle, &despertar);
+    if (despertar) portYIELD_FROM_ISR();
+}
+
+static void alVencerAntirrebote(TimerHandle_t temporizador) {
+    EstadoBoton &b = *(EstadoBoton *)pvTimerGetTimerID(temporizador);
+    portENTER_CRITICAL(&mux_botones);
+    // Se relee dentro del spinlock: un flanco posterior encuentra el bloqueo ya abierto
+    bool presionado = digitalRead(b.pin) == LOW;
+    bool corregir = presionado != b.presionado;
+    if (corregir) {
+        b.presionado = presionado;
+        publicarBoton(b, ::micros()); // Hora del fin del bloqueo, no la del flanco real
+    } else {
+        b.bloqueado = false;
+    }
+    portEXIT_CRITICAL(&mux_botones);
+    if (corregir) xTimerStart(temporizador, 0); // Solo despierta a la lógica el primer flanco
+}
+
+// Registrar desde setup() (Core 1): la interrupción queda en ese núcleo
+void configurarBoton(int pin) {
+    pinMode(pin, INPUT_PULLUP);
+    if (num_botones >= MAX_BOTONES) return;
+    EstadoBoton &b = botones[num_botones++];
+    b.pin = pin;
+    b.presionado = digitalRead(pin) == LOW; // Si ya está presionado, cuenta desde ahora
+    b.bloqueado = false;
+    b.temporizador = xTimerCreate("Antirrebote", pdMS_TO_TICKS(ANTIRREBOTE_MS), pdFALSE, &b, alVencerAntirrebote);
+    attachInterruptArg(pin, alFlancoBoton, &b, CHANGE);
+}
+
+bool sacarEventoBoton(EventoBoton &e) { return cola_botones.sacar(e); }
+
+void esperarReposo(uint32_t ms) {
+    logica_en_reposo = true;
+    if (cola_botones.vacia()) ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(ms));
+    logica_en_reposo = false;
+}
+
+// --- BUZZER ---
+// Canal LEDC del buzzer; se configura con el primer tono
+static const uint8_t CANAL_BUZZER = 0;
+static int pin_buzzer = -1;
+
+void tono(int pin, int freq) {
+    if (pin_buzzer != pin) {
+        ledcSetup(CANAL_BUZZER, 1000, 10);
+        ledcAttachPin(pin, CANAL_BUZZER);
+        pin_buzzer = pin;
+    }
+    ledcWriteTone(CANAL_BUZZER, freq);
+}
+
+void silencio(int pin) {
+    if (pin_buzzer == pin) {
+        ledcWriteTone(CANAL_BUZZER, 0);
+    } else {
+        digitalWrite(pin, LOW); // Nunca sonó: el pin sigue como GPIO
+    }
+}
+
+// --- NÚMEROS ALEATORIOS (el generador está en Hal.cpp) ---
+uint32_t semillaHardware() { return esp_random(); }
+
+// --- REGISTRO ---
+// Cada línea sale en un solo Serial.write (la UART lo hace bajo su cerrojo):
+// una traza binaria del registro nunca queda en medio de ella (Registro.h).
+static const size_t LARGO_LINEA = 192;
+
+void log(const char *msg) {
+    char linea[LARGO_LINEA];
+    size_t n = strnlen(msg, sizeof(linea) - 2);
+    memcpy(linea, msg, n);
+    linea[n++] = '\r';
+    linea[n++] = '\n';
+    Serial.write((const uint8_t *)linea, n);
+}
+
+void logf(const char *fmt, ...) {
+    char buf[LARGO_LINEA];
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    if (n < 0) return;
+    if ((size_t)n >= sizeof(buf)) {
+        n = sizeof(buf) - 1;
+        buf[n - 1] = '\n'; // Cortada: que al menos termine la línea
+    }
+    Serial.write((const uint8_t *)buf, n);
+}
+
+// --- ALMACENAMIENTO PERSISTENTE ---
+static const char *ESPACIO_NVS = "pingpong";
+
+bool leerPersistente(const char *clave, void *datos, size_t len) {
+    Preferences prefs;
+    if (!prefs.begin(ESPACIO_NVS, true)) return false; // Solo lectura; falla si nunca se guardó nada
+    bool ok = prefs.getBytesLength(clave) == len && prefs.getBytes(clave, datos, len) == len;
+    prefs.end();
+    return ok;
+}
+
+bool guardarPersistente(const char *clave, const void *datos, size_t len) {
+    Preferences prefs;
+    if (!prefs.begin(ESPACIO_NVS, false)) return false;
+    bool ok = prefs.putBytes(clave, datos, len) == len;
+    prefs.end();
+    return ok;
+}
+
+// --- ENERGÍA ---
+void dormirProfundo(uint64_t mascara_pines, uint32_t timeout_seg) {
+    esp_sleep_enable_timer_wakeup(timeout_seg * 1000000ULL);
+
+    // Despertar si CUALQUIERA de los pines en la máscara pasa a LOW (presionado)
+    esp_sleep_enable_ext1_wakeup(mascara_pines, ESP_EXT1_WAKEUP_ALL_LOW);
+
+    // CRÍTICO: SUSPENDER LA TAREA DE DIBUJO ANTES DE DORMIR
+    REGISTRO_INFO("SUSPENDIENDO TAREA DE DIBUJO (CORE 0)...");
+    if (xTaskDibujoHandle != NULL) {
+        vTaskSuspend(xTaskDibujoHandle);
+    }
+    // Lo que quede en el registro sale antes de apagar la UART (también da
+    // tiempo a que el Core 0 reciba la suspensión)
+    registro::esperarVacio(100);
+
+    esp_deep_sleep_start();
+
+    // NOTA IMPORTANTE: Si llegamos aquí, el Deep Sleep falló.
+    REGISTRO_ERROR("Fallo al entrar en Deep Sleep. Entrando en IDLE pasivo...");
+    if (xTaskLogicaJuegoHandle != NULL) {
+        vTaskSuspend(xTaskLogicaJuegoHandle); // Suspende Core 1 (Lógica)
+    }
+    vTaskSuspend(NULL); // Suspende la tarea actual si todo lo demás falla
+}
+
+// --- PANTALLA ---
+static const uint8_t *fuenteU8g2(Fuente fuente) {
+    switch (fuente) {
+        case FUENTE_7X14B: return u8g2_font_7x14B_tf;
+        case FUENTE_7X14:  return u8g2_font_7x14_tf;
+        case FUENTE_6X10:  return u8g2_font_6x10_tf;
+        case FUENTE_4X6:
+        default:           return u8g2_font_4x6_tf;
+    }
+}
+
+void Pantalla::begin() {
+    u8g2.begin();
+    diff.invalidar();
+}
+
+void Pantalla::setPowerSave(int activo) { u8g2.setPowerSave(activo); }
+void Pantalla::clearBuffer() { u8g2.clearBuffer(); }
+
+// Sustituye a u8g2.sendBuffer(): en vez de los 1024 bytes, solo los tramos de
+// fila que cambiaron. Mismos comandos que el driver ST7920 de U8g2
+// (u8x8_d_st7920.c): modo extendido, dirección Y, dirección X y datos.
+#ifndef PINGPONG_SPI_SOFTWARE
+// Por DMA: se encola y regresa; el bus trabaja mientras se dibuja el siguiente frame.
+void Pantalla::sendBuffer() {
+    TransporteST7920::enviarFrame(diff, u8g2.getBufferPtr());
+}
+bool Pantalla::envioTerminado(uint32_t &fin_us) const {
+    return TransporteST7920::frameTerminado(fin_us);
+}
+#else
+void Pantalla::sendBuffer() {
+    u8x8_t *u8x8 = u8g2.getU8x8();
+    bool transferencia_abierta = false;
+
+    diff.enviarCambios(u8g2.getBufferPtr(), [&](const DiffST7920::Tramo &t) {
+        if (!transferencia_abierta) {
+            u8x8_cad_StartTransfer(u8x8);
+            u8x8_cad_SendCmd(u8x8, 0x03e); // Modo extendido + gráficos
+            transferencia_abierta = true;
+        }
+        // La GDRAM de 128x64 es de 256x32: la mitad inferior va a la derecha
+        uint8_t fila = t.fila;
+        uint8_t palabra = t.palabra;
+        if (fila >= 32) {
+            fila -= 32;
+            palabra += 8;
+        }
+        u8x8_cad_SendCmd(u8x8, 0x080 | fila);    // Y
+        u8x8_cad_SendCmd(u8x8, 0x080 | palabra); // X (palabras de 16 px)
+        u8x8_cad_SendData(u8x8, t.bytes, (uint8_t *)t.datos);
+    });
+
+    if (transferencia_abierta) {
+        u8x8_cad_EndTransfer(u8x8);
+        fin_envio_us = ::micros();
+    }
+}
+bool Pantalla::envioTerminado(uint32_t &fin_us) const {
+    fin_us = fin_envio_us;
+    return true;
+}
+#endif
+void Pantalla::setDrawColor(int color) { u8g2.setDrawColor(color); }
+void Pantalla::setFont(Fuente fuente) { u8g2.setFont(fuenteU8g2(fuente)); }
+void Pantalla::drawStr(int x, int y, const char *str) { u8g2.drawStr(x, y, str); }
+void Pantalla::drawBox(int x, int y, int w, int h) { u8g2.drawBox(x, y, w, h); }
+void Pantalla::drawVLine(int x, int y, int h) { u8g2.drawVLine(x, y, h); }
+void Pantalla::setCursor(int x, int y) { u8g2.setCursor(x, y); }
+void Pantalla::print(const char *str) { u8g2.print(str); }
+
+} // namespace hal
@@ -0,0 +1,190 @@
+// src/Hal_native.cpp
+// Implementación de la HAL para PC (env:native). Sin hardware: reloj virtual,
+// ADC/GPIO fijados por el simulador y framebuffer en memoria.
+
+#include "Hal.h"
+#include "ColaSPSC.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace hal {
+
+Pantalla pantalla;
+
+static uint64_t reloj_us = 0;
+static int valores_adc[40];
+static int niveles_gpio[40];
+static bool log_silenciado = false;
+
+// --- RELOJ ---
+uint32_t millis() { return (uint32_t)(reloj_us / 1000); }
+uint32_t micros() { return (uint32_t)reloj_us; }
+void esperarMs(uint32_t ms) { reloj_us += (uint64_t)ms * 1000; }
+
+uint32_t contadorCiclos() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec);
+}
+
+uint32_t ciclosPorSegundo() { return 1000000000UL; }
+
+// --- ADC / GPIO ---
+// Por defecto: joysticks centrados y botones sin presionar (pull-up).
+static bool pines_iniciados = false;
+static void iniciarPines() {
+    if (pines_iniciados) return;
+    for (int i = 0; i < 40; i++) {
+        valores_adc[i] = 2048;
+        niveles_gpio[i] = NIVEL_ALTO;
+    }
+    pines_iniciados = true;
+}
+
+void configurarEntrada(int pin) { iniciarPines(); (void)pin; }
+void configurarSalida(int pin) { (void)pin; }
+
+int leerADC(int pin) {
+    iniciarPines();
+    return (pin >= 0 && pin < 40) ? valores_adc[pin] : 0;
+}
+
+int leerGPIO(int pin) {
+    iniciarPines();
+    return (pin >= 0 && pin < 40) ? niveles_gpio[pin] : NIVEL_ALTO;
+}
+
+// --- BOTONES ---
+// Sin rebotes en el simulador: fijarGPIO() sobre un botón publica el evento al momento
+static bool es_boton[40];
+static ColaSPSC<EventoBoton, 32> cola_botones;
+
+void configurarBoton(int pin) {
+    iniciarPines();
+    if (pin >= 0 && pin < 40) es_boton[pin] = true;
+}
+
+bool sacarEventoBoton(EventoBoton &e) { return cola_botones.sacar(e); }
+
+void esperarReposo(uint32_t ms) {
+    if (cola_botones.vacia()) esperarMs(ms);
+}
+
+// --- BUZZER (sin sonido en PC) ---
+void tono(int pin, int freq) { (void)pin; (void)freq; }
+void silencio(int pin) { (void)pin; }
+
+// --- NÚMEROS ALEATORIOS (el generador está en Hal.cpp) ---
+uint32_t semillaHardware() { return 0x50494E47; }
+
+// --- REGISTRO ---
+void log(const char *msg) {
+    if (!log_silenciado) puts(msg);
+}
+
+void logf(const char *fmt, ...) {
+    if (log_silenciado) return;
+    va_list args;
+    va_start(args, fmt);
+    vprintf(fmt, args);
+    va_end(args);
+}
+
+// --- ALMACENAMIENTO PERSISTENTE ---
+// Solo dura lo que dura el proceso: cada simulación arranca sin datos guardados.
+static std::map<std::string, std::vector<uint8_t> > almacen;
+
+bool leerPersistente(const char *clave, void *datos, size_t len) {
+    std::map<std::string, std::vector<uint8_t> >::const_iterator it = almacen.find(clave);
+    if (it == almacen.end() || it->second.size() != len) return false;
+    memcpy(datos, it->second.data(), len);
+    return true;
+}
+
+bool guardarPersistente(const char *clave, const void *datos, size_t len) {
+    const uint8_t *bytes = (const uint8_t *)datos;
+    almacen[clave].assign(bytes, bytes + len);
+    return true;
+}
+
+// --- ENERGÍA ---
+// En PC no hay Deep Sleep: se informa y se regresa como si hubiese fallado.
+void dormirProfundo(uint64_t mascara_pines, uint32_t timeout_seg) {
+    logf("[sim] Deep Sleep (mascara=0x%llx, timeout=%u s) no disponible en PC\n",
+         (unsigned long long)mascara_pines, (unsigned)timeout_seg);
+}
+
+// --- PANTALLA (framebuffer en memoria) ---
+void Pantalla::begin() {
+    memset(buffer, 0, sizeof(buffer));
+    diff.invalidar();
+}
+
+void Pantalla::setPowerSave(int activo) { apagada = (activo != 0); }
+void Pantalla::clearBuffer() { memset(buffer, 0, sizeof(buffer)); }
+
+// Sin bus real: solo se calcula qué se enviaría (estadísticas en 'diff')
+void Pantalla::sendBuffer() {
+    diff.enviarCambios(buffer, [](const DiffST7920::Tramo &) {});
+    if (diff.bytes_ultimo_frame > 0) fin_envio_us = micros();
+}
+bool Pantalla::envioTerminado(uint32_t &fin_us) const {
+    fin_us = fin_envio_us;
+    return true;
+}
+void Pantalla::setDrawColor(int c) { color = c; }
+void Pantalla::setFont(Fuente fuente) { (void)fuente; }
+
+void Pantalla::pixel(int x, int y) {
+    if (x < 0 || x >= ANCHO || y < 0 || y >= ALTO) return;
+    uint8_t mascara = 0x80 >> (x & 7);
+    uint8_t &b = buffer[y * (ANCHO / 8) + (x >> 3)];
+    if (color) b |= mascara; else b &= ~mascara;
+}
+
+void Pantalla::drawBox(int x, int y, int w, int h) {
+    for (int j = y; j < y + h; j++) {
+        for (int i = x; i < x + w; i++) pixel(i, j);
+    }
+}
+
+void Pantalla::drawVLine(int x, int y, int h) { drawBox(x, y, 1, h); }
+
+// El texto no se rasteriza en PC: basta con que el código de dibujo se ejecute.
+void Pantalla::drawStr(int x, int y, const char *str) { (void)x; (void)y; (void)str; }
+void Pantalla::setCursor(int x, int y) { cursor_x = x; cursor_y = y; }
+void Pantalla::print(const char *str) { drawStr(cursor_x, cursor_y, str); }
+
+// --- CONTROLES DEL SIMULADOR ---
+namespace sim {
+
+void avanzarReloj(uint32_t us) { reloj_us += us; }
+
+void fijarADC(int pin, int valor) {
+    iniciarPines();
+    if (pin >= 0 && pin < 40) valores_adc[pin] = valor;
+}
+
+void fijarGPIO(int pin, int nivel) {
+    iniciarPines();
+    if (pin < 0 || pin >= 40) return;
+    if (es_boton[pin] && niveles_gpio[pin] != nivel) {
+        EventoBoton e;
+        e.marca_us = micros();
+        e.pin = (uint8_t)pin;
+        e.presionado = (nivel == NIVEL_BAJO);
+        cola_botones.meter(e);
+    }
+    niveles_gpio[pin] = nivel;
+}
+
+void silenciarLog(bool silenciar) { log_silenciado = silenciar; }
+
+} // namespace sim
+
+} // namespace hal
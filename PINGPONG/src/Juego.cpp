@@ -1,15 +1,9 @@
 #include "Juego.h"
-#include "esp_sleep.h"
-#include "freertos/FreeRTOS.h"
-#include "freertos/task.h"
+#include "Registro.h"
+#include <stdio.h>
+#include <stdlib.h>
 
-// Definición de variables globales y externas (debe ser definida una vez)
-extern U8G2_ST7920_128X64_1_SW_SPI u8g2;
-portMUX_TYPE scoreMux = portMUX_INITIALIZER_UNLOCKED;
-
-// --- Declaración externa de los handles de las tareas (definidas en main.cpp) ---
-extern TaskHandle_t xTaskLogicaJuegoHandle;
-extern TaskHandle_t xTaskDibujoHandle;
+using hal::pantalla;
 
 // --- Declaración externa de la variable RTC (definida en main.cpp) ---
 extern RtcData_t rtc_game_state;
@@ -24,15 +18,64 @@ Juego::Juego()
       menuSelection(0),
       score_p1(0),
       score_p2(0),
-      btn1_last_state(HIGH),
-      last_debounce_time(0),
-      btn1_debounced_state(HIGH),
-      btn2_debounced_state(HIGH),
+      last_activity_time(hal::millis()), // Inicialización correcta
+      boton1_local(false),
+      boton2_local(false),
+      btn1_debounced_state(hal::NIVEL_ALTO),
+      btn2_debounced_state(hal::NIVEL_ALTO),
       btn1_just_pressed(false),
       btn2_just_pressed(false),
-      last_activity_time(millis()) // Inicialización correcta
+      audio(PIN_BUZZER),
+      perfil_logica(PRESUPUESTO_LOGICA_US),
+      perfil_dibujo(PRESUPUESTO_DIBUJO_US),
+      hud_activo(false),
+      calibracion_pedida(false),
+      ultima_publicada()
 {
+    pelota.conectarAudio(&audio);
     // Si despertamos del Deep Sleep, la lógica de main.cpp ya restauró el estado.
+    publicarInstantanea();
+}
+
+// Compara solo lo que se dibuja (la traza de latencia viaja aparte)
+static bool mismaImagen(const InstantaneaJuego &a, const InstantaneaJuego &b) {
+    return a.gameState == b.gameState &&
+           a.menuSelection == b.menuSelection &&
+           a.eligiendoDificultad == b.eligiendoDificultad &&
+           a.score_p1 == b.score_p1 && a.score_p2 == b.score_p2 &&
+           a.paleta1_x == b.paleta1_x && a.paleta1_y == b.paleta1_y &&
+           a.paleta2_x == b.paleta2_x && a.paleta2_y == b.paleta2_y &&
+           a.pelota_x == b.pelota_x && a.pelota_y == b.pelota_y &&
+           a.aviso_dormir_seg == b.aviso_dormir_seg;
+}
+
+// Copia en la instantánea libre lo que se dibuja y la publica (Core 1)
+bool Juego::publicarInstantanea() {
+    InstantaneaJuego &s = instantanea.paraEscribir();
+    s.gameState = gameState;
+    s.menuSelection = menuSelection;
+    s.eligiendoDificultad = eligiendoDificultad;
+    s.score_p1 = score_p1;
+    s.score_p2 = score_p2;
+    s.paleta1_x = paleta1.x;
+    s.paleta1_y = paleta1.y;
+    s.paleta2_x = paleta2.x;
+    s.paleta2_y = paleta2.y;
+    s.pelota_x = escalarAEntero(pelota.x);
+    s.pelota_y = escalarAEntero(pelota.y);
+    // La cuenta atrás la calcula la lógica: así cambia la instantánea cada segundo
+    long restante_ms = (long)INACTIVITY_TIMEOUT_MS - (long)(hal::millis() - last_activity_time);
+    if (restante_ms > 3000) {
+        s.aviso_dormir_seg = -1;
+    } else {
+        s.aviso_dormir_seg = restante_ms > 0 ? (int)(restante_ms / 1000) : 0;
+    }
+    s.traza = traza_mando;
+
+    bool cambio = !mismaImagen(s, ultima_publicada);
+    ultima_publicada = s;
+    instantanea.publicar();
+    return cambio;
 }
 
 // Método auxiliar para reiniciar la partida
@@ -44,93 +87,212 @@ void Juego::reiniciarJuego() {
     menuSelection = 0;
 }
 
+// --- Recepción de los mandos (tarea WiFi) ---
+// Solo copia el paquete a la cola del jugador: nunca espera a la lógica
+bool Juego::recibirPaquete(const uint8_t *datos, int len) {
+    // 1. Validar tamaño y versión y reconstruir las muestras (vieja -> nueva)
+    protocolo::CabeceraMando_t cab;
+    protocolo::MuestraMando_t muestras[protocolo::MAX_MUESTRAS_ANTERIORES + 1];
+    int n = protocolo::leerTrama(datos, len, cab, muestras);
+    if (n == 0) return false;
+
+    int jugador = protocolo::jugadorDe(cab.carga);
+    if (jugador != 1 && jugador != 2) return false;
+    int j = jugador - 1;
+
+    // 2. Estadísticas del enlace; las tramas viejas o repetidas no se usan.
+    // Si el mando estuvo callado (dormido o reiniciado) su secuencia vuelve a empezar.
+    EstadisticasEnlace &enlace = (jugador == 1) ? enlace_j1 : enlace_j2;
+    uint32_t ahora_us = hal::micros();
+    if (enlace.recibidas > 0 && ahora_us - enlace.ultimaLlegadaUs() > protocolo::MS_MANDO_INACTIVO * 1000UL) {
+        enlace.resincronizar();
+        hay_muestra_entregada[j] = false;
+    }
+    if (!enlace.registrar(cab.secuencia, cab.marca, ahora_us)) return false;
+
+    // 3. Encolar solo las muestras que aún no se entregaron: si se perdieron
+    // tramas, sus muestras salen de las copias de esta
+    ColaSPSC<MuestraRemota_t, TAMANO_COLA_REMOTA> &cola = (jugador == 1) ? cola_remota_j1 : cola_remota_j2;
+    uint32_t ahora_ms = hal::millis();
+    bool ok = true;
+    for (int i = 0; i < n; i++) {
+        const protocolo::MuestraMando_t &m = muestras[i];
+        if (hay_muestra_entregada[j] && (int8_t)(uint8_t)(m.secuencia - ultima_muestra_entregada[j]) <= 0) continue;
+        if (i < n - 1 && hay_muestra_entregada[j]) enlace.contarRecuperada();
+
+        MuestraRemota_t muestra;
+        muestra.marca_ms = ahora_ms;
+        muestra.llegada_us = ahora_us;
+        muestra.marca_emisor = m.marca;
+        muestra.espera_us = (uint32_t)(uint16_t)(cab.marca - m.marca) * protocolo::US_POR_MARCA;
+        muestra.joy_y_val = (int16_t)m.eje;
+        muestra.btn_pressed = m.boton;
+        ok = cola.meter(muestra) && ok;
+
+        ultima_muestra_entregada[j] = m.secuencia;
+        hay_muestra_entregada[j] = true;
+    }
+    return ok;
+}
+
+// --- Vaciado de las colas remotas (Core 1, al inicio de cada paso) ---
+// El joystick toma la última muestra; el botón cuenta como presionado si
+// cualquier muestra del paso lo estaba, así no se pierde una pulsación corta
+// que llegó y se soltó entre dos pasos.
+void Juego::vaciarColasRemotas() {
+    MuestraRemota_t m;
+    bool hubo = false;
+    bool boton = false;
+    while (cola_remota_j1.sacar(m)) {
+        if (calibracion.grabando()) calibracion.observar(Calibracion::REMOTO_J1, m.joy_y_val);
+        int lineal = calibracion.linealizar(Calibracion::REMOTO_J1, m.joy_y_val);
+        predictor_j1.agregar(lineal, m.marca_emisor, m.llegada_us, m.espera_us);
+        remote_joy_y_val = EjeCalibrado::recortar(lineal);
+        last_remote_packet = m.marca_ms;
+        boton = boton || m.btn_pressed;
+        hubo = true;
+    }
+    if (hubo) {
+        remote_control_active = true;
+        remote_btn_pressed = boton;
+        last_activity_time = hal::millis();
+        trazarMuestra(m, predictor_j1);
+        REGISTRO_TRAZA(registro::TRAZA_MUESTRA_REMOTA, 1, (uint32_t)remote_joy_y_val,
+                       traza_mando.recibida_us - traza_mando.tomada_us);
+    }
+
+    hubo = false;
+    boton = false;
+    while (cola_remota_j2.sacar(m)) {
+        if (calibracion.grabando()) calibracion.observar(Calibracion::REMOTO_J2, m.joy_y_val);
+        int lineal = calibracion.linealizar(Calibracion::REMOTO_J2, m.joy_y_val);
+        predictor_j2.agregar(lineal, m.marca_emisor, m.llegada_us, m.espera_us);
+        remote_joy_y_val_j2 = EjeCalibrado::recortar(lineal);
+        last_remote_packet_j2 = m.marca_ms;
+        boton = boton || m.btn_pressed;
+        hubo = true;
+    }
+    if (hubo) {
+        remote_control_active_j2 = true;
+        remote_btn_pressed_j2 = boton;
+        last_activity_time = hal::millis();
+        trazarMuestra(m, predictor_j2);
+        REGISTRO_TRAZA(registro::TRAZA_MUESTRA_REMOTA, 2, (uint32_t)remote_joy_y_val_j2,
+                       traza_mando.recibida_us - traza_mando.tomada_us);
+    }
+}
+
+// Marcas de la muestra más nueva del paso para LatenciaMando. La hora en que
+// el mando la midió se estima con el retardo de radio de su predictor.
+void Juego::trazarMuestra(const MuestraRemota_t &m, const PredictorMando &predictor) {
+    traza_mando.numero++;
+    if (traza_mando.numero == 0) traza_mando.numero = 1; // 0 = sin muestra
+    traza_mando.tomada_us = m.llegada_us - m.espera_us - predictor.retardoUs();
+    traza_mando.recibida_us = m.llegada_us;
+    traza_mando.consumida_us = hal::micros();
+    latencia.alConsumir(traza_mando);
+}
+
 // --- Lógica básica para que la Paleta 2 siga a la Pelota (IA)
 void Juego::logica_IA() {
     // 1. Encontrar el centro de la pelota
-    int target_y = (int)pelota.y + pelota.TAMANO / 2;
+    int target_y = escalarAEntero(pelota.y) + pelota.TAMANO / 2;
     int paleta_max_y = 64 - paleta2.ALTO;
 
     // --- LÓGICA DE DIFICULTAD ---
+    // Suavizados por tick de 200 Hz convertidos al paso de física (constantes de compilación)
+    constexpr Escalar SUAVIZADO_FACIL = escalarDe(suavizadoPorPaso(0.05));
+    constexpr Escalar SUAVIZADO_NORMAL = escalarDe(suavizadoPorPaso(0.15));
+    constexpr Escalar SUAVIZADO_DIFICIL = escalarDe(suavizadoPorPaso(0.4));
     int margen_error;
-    float velocidad_suavizado;
+    Escalar velocidad_suavizado;
 
     switch(dificultadIA) {
         case 0: // FÁCIL: La IA es lenta y se despista mucho
             margen_error = 15; 
-            velocidad_suavizado = 0.05; // Reacciona muy lento
+            velocidad_suavizado = SUAVIZADO_FACIL; // Reacciona muy lento
             break;
         case 1: // NORMAL: Equilibrio
             margen_error = 7;
-            velocidad_suavizado = 0.15; 
+            velocidad_suavizado = SUAVIZADO_NORMAL; 
             break;
         case 2: // DIFÍCIL: Casi perfecta
         default:
             margen_error = 2;
-            velocidad_suavizado = 0.4; 
+            velocidad_suavizado = SUAVIZADO_DIFICIL; 
             break;
     }
 
     // 2. Solo moverse si la pelota está fuera del "margen de error" 
     // Esto evita que la paleta vibre y permite que falle si la pelota va muy rápido
-    static float y_suave = 32; // Posición interna para suavizar movimiento
+    static Escalar y_suave = 32; // Posición interna para suavizar movimiento
     
-    if (abs(target_y - (y_suave + paleta2.ALTO/2)) > margen_error) {
+    if (valorAbsoluto(target_y - (y_suave + paleta2.ALTO/2)) > margen_error) {
         // La paleta intenta alcanzar el objetivo pero no instantáneamente
         y_suave += (target_y - (y_suave + paleta2.ALTO/2)) * velocidad_suavizado;
     }
 
     // 3. Calcular el punto Y superior y restringirlo
-    int target_top_y = (int)y_suave - (paleta2.ALTO / 2);
-    target_top_y = constrain(target_top_y, 0, paleta_max_y);
+    int target_top_y = escalarAEntero(y_suave) - (paleta2.ALTO / 2);
+    target_top_y = hal::limitar(target_top_y, 0, paleta_max_y);
 
     // 4. Mapear a 0-4095 para usar tu sistema de actualización de posición
-    float joy_float = (float)target_top_y * 4095.0f / (float)paleta_max_y;
-    paleta2.actualizarPosicion((int)joy_float);
+    // (Aritmética entera: mismo resultado que la versión float, ambos valores son positivos)
+    int joy_ia = (target_top_y * 4095) / paleta_max_y;
+    paleta2.actualizarPosicion(joy_ia);
 }
 // --- Manejo de la entrada del Botón 1 y Botón 2 (Flanco descendente debounced, Confirmar)
 void Juego::checkInput() {
-    // 1. Leer pines locales
-    int reading1 = digitalRead(PIN_BUTTON_1);
-    int reading2 = digitalRead(PIN_BUTTON_2);
+    // 1. Eventos de los botones locales (interrupción + antirrebote en la HAL).
+    // Una pulsación que empezó y terminó desde el paso anterior llega como dos
+    // eventos: el flanco de bajada se recuerda aunque el botón ya esté suelto.
+    bool pulso1 = false;
+    bool pulso2 = false;
+    hal::EventoBoton e;
+    while (hal::sacarEventoBoton(e)) {
+        REGISTRO_TRAZA(registro::TRAZA_BOTON, e.pin, e.presionado, e.marca_us);
+        if (e.pin == PIN_BUTTON_1) {
+            boton1_local = e.presionado;
+            pulso1 = pulso1 || e.presionado;
+        } else if (e.pin == PIN_BUTTON_2) {
+            boton2_local = e.presionado;
+            pulso2 = pulso2 || e.presionado;
+        }
+    }
     
     // 2. Limpiar señales remotas si el mando se desconecta
     if (!remote_control_active) remote_btn_pressed = false;
     if (!remote_control_active_j2) remote_btn_pressed_j2 = false;
 
     // 3. LÓGICA OR (CORREGIDA): J1 local o remoto / J2 local o remoto
-    bool btn1_active = (reading1 == LOW) || remote_btn_pressed;
-    bool btn2_active = (reading2 == LOW) || remote_btn_pressed_j2; // Aquí estaba el error (tenías reading1)
+    bool btn1_active = boton1_local || remote_btn_pressed;
+    bool btn2_active = boton2_local || remote_btn_pressed_j2;
 
     // Reiniciamos flancos
     btn1_just_pressed = false;
     btn2_just_pressed = false;
 
     // --- PROCESAR JUGADOR 1 ---
-    if (btn1_active && btn1_debounced_state == HIGH) {
+    if ((btn1_active || pulso1) && btn1_debounced_state == hal::NIVEL_ALTO) {
         btn1_just_pressed = true; 
-        btn1_debounced_state = LOW;
-        last_activity_time = millis(); 
-        Serial.println("Click: Jugador 1 (Local o Remoto)");
+        btn1_debounced_state = hal::NIVEL_BAJO;
+        last_activity_time = hal::millis(); 
+        REGISTRO_INFO("Click: Jugador 1 (Local o Remoto)");
     }
-    else if (!btn1_active && btn1_debounced_state == LOW) {
-        btn1_debounced_state = HIGH;
+    else if (!btn1_active && btn1_debounced_state == hal::NIVEL_BAJO) {
+        btn1_debounced_state = hal::NIVEL_ALTO;
     }
 
     // --- PROCESAR JUGADOR 2 ---
-    if (btn2_active && btn2_debounced_state == HIGH) {
+    if ((btn2_active || pulso2) && btn2_debounced_state == hal::NIVEL_ALTO) {
         btn2_just_pressed = true; 
-        btn2_debounced_state = LOW;
-        last_activity_time = millis(); 
-        Serial.println("Click: Jugador 2 (Local o Remoto)");
+        btn2_debounced_state = hal::NIVEL_BAJO;
+        last_activity_time = hal::millis(); 
+        REGISTRO_INFO("Click: Jugador 2 (Local o Remoto)");
     }
-    else if (!btn2_active && btn2_debounced_state == LOW) {
-        btn2_debounced_state = HIGH;
+    else if (!btn2_active && btn2_debounced_state == hal::NIVEL_BAJO) {
+        btn2_debounced_state = hal::NIVEL_ALTO;
     }
-    
-    // Guardar estados anteriores (opcional, por compatibilidad)
-    btn1_last_state = reading1;
-    // Si usas btn2_last_state en Juego.h, añádelo aquí:
-    // btn2_last_state = reading2; 
 }
 
 // --- Implementación del Deep Sleep ---
@@ -148,104 +310,97 @@ void Juego::entrarEnDeepSleep() {
     }
 
     // 2. Apagar la pantalla U8g2
-    u8g2.setPowerSave(1);
+    pantalla.setPowerSave(1);
 
     // 3. Apagar el buzzer (si está encendido)
-    noTone(PIN_BUZZER);
-
-    Serial.println("Entrando en modo Deep Sleep por inactividad...");
-    Serial.printf("Despertara en %d segundos o al presionar un botón\n", DEEP_SLEEP_TIMEOUT_SEC);
+    hal::silencio(PIN_BUZZER);
 
-    // 4. Configurar la fuente de despertar (EXT1):
-    esp_sleep_enable_timer_wakeup(DEEP_SLEEP_TIMEOUT_SEC * 1000000ULL);
+    REGISTRO_INFO("Entrando en modo Deep Sleep por inactividad...");
+    REGISTRO_INFO("Despertara en %d segundos o al presionar un botón", DEEP_SLEEP_TIMEOUT_SEC);
 
+    // 4. Configurar la fuente de despertar (EXT1) y dormir.
     // Máscara de pines RTC que activarán el despertar
     const uint64_t wakeup_mask = (1ULL << PIN_BUTTON_1) | (1ULL << PIN_BUTTON_2);
 
-    // Despertar si CUALQUIERA de los pines en la máscara pasa a LOW (presionado)
-    esp_sleep_enable_ext1_wakeup(wakeup_mask, ESP_EXT1_WAKEUP_ALL_LOW);
-
-    // 5. CRÍTICO: SUSPENDER LA TAREA DE DIBUJO ANTES DE DORMIR
-    Serial.println("SUSPENDIENDO TAREA DE DIBUJO (CORE 0)...");
-    if (xTaskDibujoHandle != NULL) {
-        vTaskSuspend(xTaskDibujoHandle);
-    }
-    // Damos un breve tiempo para que Core 0 reciba la suspensión.
-    vTaskDelay(pdMS_TO_TICKS(5));
-
-    // 6. Entrar en Deep Sleep
-    esp_deep_sleep_start();
-
-    // NOTA IMPORTANTE: Si llegamos aquí, el Deep Sleep falló.
-    Serial.println("ERROR: Fallo al entrar en Deep Sleep. Entrando en IDLE pasivo...");
-    // 7. Si falla, entrar en IDLE pasivo forzado:
-    if (xTaskLogicaJuegoHandle != NULL) {
-        vTaskSuspend(xTaskLogicaJuegoHandle); // Suspende Core 1 (Lógica)
-    }
-    if (xTaskDibujoHandle != NULL) {
-        vTaskSuspend(xTaskDibujoHandle);
-    }
-    vTaskSuspend(NULL); // Suspende la tarea actual si todo lo demás falla
+    // 5. La HAL suspende la tarea de dibujo y entra en Deep Sleep.
+    // Si regresa, el Deep Sleep falló y la plataforma ya dejó las tareas en IDLE pasivo.
+    hal::dormirProfundo(wakeup_mask, DEEP_SLEEP_TIMEOUT_SEC);
 }
 
 // --- Lógica Principal del Juego (CORE 1)
-void Juego::actualizarLogica() {
+// Un paso completo y, al terminar, la instantánea para la tarea de dibujo
+bool Juego::actualizarLogica() {
+    procesarPaso();
+    return publicarInstantanea();
+}
+
+void Juego::procesarPaso() {
     // ------------------------------------------------------------------
     // NUEVO: Temporizador estático para limitar la velocidad de navegación del menú
     static unsigned long last_menu_move_time = 0;
     // REDUCIDO DE 200 a 100ms para mejorar la respuesta del joystick en el menú.
     const unsigned long MENU_MOVE_DELAY = 100;
-
-    // NUEVOS UMBRALES DE JOYSTICK: Más sensibles para la navegación del menú.
-    // Centro es 2048. 1500 y 2500 requieren menos movimiento que 1000 y 3000.
-    const int THRESHOLD_UP_MENU = 1500;
-    const int THRESHOLD_DOWN_MENU = 2500;
     // ------------------------------------------------------------------
 
-    // 1. Lectura y procesamiento de entradas
+    // Recalibración pedida desde otra tarea (main.cpp)
+    if (calibracion_pedida.exchange(false, std::memory_order_relaxed)) {
+        empezarCalibracion();
+    }
+
+    // 1. Lectura y procesamiento de entradas (primero las muestras de los mandos)
+    vaciarColasRemotas();
     checkInput();
 
  // Leer joysticks ANTES de la lógica para detectar actividad
-    int joy1_val_local = analogRead(PIN_JOYSTICK_1_Y);
-    int joy2_val = analogRead(PIN_JOYSTICK_2_Y);
+    int joy1_crudo = hal::leerADC(PIN_JOYSTICK_1_Y);
+    int joy2_crudo = hal::leerADC(PIN_JOYSTICK_2_Y);
+    if (calibracion.grabando()) {
+        calibracion.observar(Calibracion::LOCAL_J1, joy1_crudo);
+        calibracion.observar(Calibracion::LOCAL_J2, joy2_crudo);
+    }
+    // Una consulta a la tabla por muestra: de aquí en adelante todo está en la
+    // escala normalizada (centro 2048, zona muerta y extremos ya aplicados)
+    int joy1_val_local = calibracion.aplicar(Calibracion::LOCAL_J1, joy1_crudo);
+    int joy2_val = calibracion.aplicar(Calibracion::LOCAL_J2, joy2_crudo);
     int joy1_val_final; // Valor que se usará para Paleta 1
     int joy2_val_final;
     // --- MANEJO DEL CONTROL REMOTO (Remote Control Handler) ---
-    portENTER_CRITICAL(&scoreMux);
-    // Desactivar el control remoto si no se ha recibido nada en 100ms
-    if (remote_control_active && (millis() - last_remote_packet) > 100) {
+    // Desactivar el control remoto si no se ha recibido nada en 150ms
+    // (el mando quieto solo manda cada 50 ms, ver Protocolo.h)
+    if (remote_control_active && (hal::millis() - last_remote_packet) > protocolo::MS_MANDO_INACTIVO) {
         remote_control_active = false;
     }
-    if (remote_control_active_j2 && (millis() - last_remote_packet_j2) > 100) {
+    if (remote_control_active_j2 && (hal::millis() - last_remote_packet_j2) > protocolo::MS_MANDO_INACTIVO) {
         remote_control_active_j2 = false;
-        // Serial.println("Control remoto inactivo."); // Descomentar para debug
+        REGISTRO_DEPURACION("Control remoto J2 inactivo"); // Con -D PINGPONG_NIVEL_LOG=4
     }
 
+    // Mando remoto: valor extrapolado al instante de este paso (PredictorMando.h),
+    // con la zona muerta y los extremos aplicados después de extrapolar
+    uint32_t ahora_us = hal::micros();
     if (remote_control_active) {
-        joy1_val_final = remote_joy_y_val;
+        joy1_val_final = EjeCalibrado::recortar(predictor_j1.estimar(ahora_us));
     } else {
         joy1_val_final = joy1_val_local;
     }
     if (remote_control_active_j2) {
-        joy2_val_final = remote_joy_y_val_j2;
+        joy2_val_final = EjeCalibrado::recortar(predictor_j2.estimar(ahora_us));
     } else {
         joy2_val_final = joy2_val;
     }
-   
-    portEXIT_CRITICAL(&scoreMux);
 
     // --- REINICIO DE CONTADOR POR MOVIMIENTO DE JOYSTICK ---
-    // Si el valor está fuera de la zona muerta central (ej. 2048 +/- 500), es actividad.
-    const int THRESHOLD = 500;
+    // Si el valor está fuera de la zona muerta central (2048 +/- 500), es actividad.
+    bool joy1_activo = abs(joy1_val_local - EJE_CENTRO) > EJE_UMBRAL_ACTIVIDAD;
 
     // Detección de actividad local O remota
-    if (abs(joy1_val_local - 2048) > THRESHOLD || remote_control_active) {
-        last_activity_time = millis();
+    if (joy1_activo || remote_control_active) {
+        last_activity_time = hal::millis();
     }
 
     // --- REGLA DE INACTIVIDAD AUTOMÁTICA ---
     // El contador corre en TODOS los estados excepto IDLE
-    if (gameState != STATE_IDLE && (millis() - last_activity_time) >= INACTIVITY_TIMEOUT_MS) {
+    if (gameState != STATE_IDLE && (hal::millis() - last_activity_time) >= INACTIVITY_TIMEOUT_MS) {
 
         // --- TRANSICIÓN A IDLE (Modo Ahorro) ---
         // 1. Guardar estado actual antes de cambiar.
@@ -262,7 +417,7 @@ void Juego::actualizarLogica() {
     // Si estamos en IDLE, la única actividad que hacemos es verificar si salir.
     if (gameState == STATE_IDLE) {
         // Verificar actividad de botones o joysticks (local o remota)
-        if (btn1_just_pressed || btn2_just_pressed || abs(joy1_val_local - 2048) > THRESHOLD ||  remote_control_active||  remote_control_active_j2) {
+        if (btn1_just_pressed || btn2_just_pressed || joy1_activo ||  remote_control_active||  remote_control_active_j2) {
 
              GameState_t previous_state = state_before_idle;
 
@@ -275,11 +430,11 @@ void Juego::actualizarLogica() {
                  gameState = previous_state;
              }
 
-             last_activity_time = millis(); // Reiniciar temporizador
+             last_activity_time = hal::millis(); // Reiniciar temporizador
              return;
         }
-        // Si estamos inactivos, esperamos un poco más antes de la siguiente revisión de lógica
-        vTaskDelay(pdMS_TO_TICKS(100)); // Ralentiza la lógica a 10 FPS
+        // Si estamos inactivos, Task_LogicaJuego baja su frecuencia a 10 Hz
+        // (ver enReposo()); aquí no se bloquea para no romper el paso fijo.
         return; // No procesar más lógica de juego en estado IDLE
     }
 
@@ -293,16 +448,15 @@ void Juego::actualizarLogica() {
     // 1. Lectura de valores finales (considerando remoto o local)
     // Esto debe estar antes de la máquina de estados
     // --- DETECCIÓN INDEPENDIENTE ---
-    // Forzar valores a 2048 (centro) si están cerca para evitar que un joystick bloquee al otro
-    if (abs(joy1_val_final - 2048) < 300) joy1_val_final = 2048;
-    if (abs(joy2_val_final - 2048) < 300) joy2_val_final = 2048;
+    // La zona muerta central ya viene de la calibración, así un
+    // joystick en reposo no bloquea al otro
     // Joystick 1
-    bool j1_sube = (joy1_val_final < THRESHOLD_UP_MENU);
-    bool j1_baja = (joy1_val_final > THRESHOLD_DOWN_MENU);
+    bool j1_sube = (joy1_val_final < EJE_CENTRO - EJE_UMBRAL_MENU_SUBE);
+    bool j1_baja = (joy1_val_final > EJE_CENTRO + EJE_UMBRAL_MENU_BAJA);
 
     // Joystick 2 (CORREGIDO: aquí estaba el error de lógica)
-    bool j2_sube = (remote_joy_y_val_j2 < THRESHOLD_UP_MENU);
-    bool j2_baja = (remote_joy_y_val_j2 > THRESHOLD_DOWN_MENU);
+    bool j2_sube = (remote_joy_y_val_j2 < EJE_CENTRO - EJE_UMBRAL_MENU_SUBE);
+    bool j2_baja = (remote_joy_y_val_j2 > EJE_CENTRO + EJE_UMBRAL_MENU_BAJA);
 
     // --- COMBINACIÓN FINAL ---
     // El menú se mueve si CUALQUIERA de los dos actúa
@@ -320,18 +474,18 @@ void Juego::actualizarLogica() {
 
     case STATE_PLAYER_SELECT:
         // --- NAVEGACIÓN DEL MENÚ ---
-        if ((millis() - last_menu_move_time) > MENU_MOVE_DELAY) {
+        if ((hal::millis() - last_menu_move_time) > MENU_MOVE_DELAY) {
             if (move_up) {
                 if (menuSelection > 0) {
                     menuSelection--;
-                    last_menu_move_time = millis();
+                    last_menu_move_time = hal::millis();
                 }
             } else if (move_down) {
                 // Si estamos eligiendo dificultad hay 3 opciones (0,1,2), si no solo 2 (0,1)
                 int limiteMax = eligiendoDificultad ? 2 : 1;
                 if (menuSelection < limiteMax) {
                     menuSelection++;
-                    last_menu_move_time = millis();
+                    last_menu_move_time = hal::millis();
                 }
             }
         }
@@ -346,12 +500,12 @@ void Juego::actualizarLogica() {
                         score_p1 = 0;
                         score_p2 = 0;
                         pelota.reiniciar();
-                        last_activity_time = millis(); // Reset para que no entre en sleep
-                        Serial.println("Iniciando Modo 2 Jugadores"); // Debug
+                        last_activity_time = hal::millis(); // Reset para que no entre en sleep
+                        REGISTRO_INFO("Iniciando Modo 2 Jugadores"); // Debug
                     } else { // --- CASO VS MÁQUINA ---
                         eligiendoDificultad = true; 
                         menuSelection = 0; 
-                        last_menu_move_time = millis();
+                        last_menu_move_time = hal::millis();
                     }
             } else {
                 // --- ESTAMOS ELIGIENDO DIFICULTAD ---
@@ -383,19 +537,19 @@ void Juego::actualizarLogica() {
 
             // --- ACTUALIZACIÓN DE PALETAS CON CONTROL REMOTO/LOCAL ---
             if (gameState == STATE_VS_PLAYER) {
-                paleta1.actualizarPosicion(joy1_val_final); // Usa valor final (local o remoto)
-                paleta2.actualizarPosicion(joy2_val_final);
+                paleta1.actualizarPosicion(joy1_val_final, remote_control_active); // Usa valor final (local o remoto)
+                paleta2.actualizarPosicion(joy2_val_final, remote_control_active_j2);
             } else { // STATE_VS_AI
-                paleta1.actualizarPosicion(joy1_val_final); // Usa valor final (local o remoto)
+                paleta1.actualizarPosicion(joy1_val_final, remote_control_active); // Usa valor final (local o remoto)
                 logica_IA();
             }
 
-            portENTER_CRITICAL(&scoreMux);
+            // Sin cerrojo: la tarea de dibujo lee los marcadores de la instantánea
             pelota.actualizar(paleta1, paleta2, score_p1, score_p2);
-            portEXIT_CRITICAL(&scoreMux);
 
             // --- Verificación de Victoria ---
             if (score_p1 >= MAX_SCORE || score_p2 >= MAX_SCORE) {
+                audio.publicar(Audio::EVENTO_FIN_PARTIDA);
                 gameState = STATE_GAME_OVER;
                 menuSelection = 0; // Rematch por defecto
             }
@@ -403,13 +557,13 @@ void Juego::actualizarLogica() {
 
         case STATE_PAUSED:
             // --- NAVEGACIÓN DEL MENÚ (Corregida con temporizador) ---
-            if ((millis() - last_menu_move_time) > MENU_MOVE_DELAY) {
+            if ((hal::millis() - last_menu_move_time) > MENU_MOVE_DELAY) {
                 if (move_up) {
                     if (menuSelection > 0) menuSelection = 0;
-                    last_menu_move_time = millis();
+                    last_menu_move_time = hal::millis();
                 } else if (move_down) {
                     if (menuSelection < 1) menuSelection = 1;
-                    last_menu_move_time = millis();
+                    last_menu_move_time = hal::millis();
                 }
             }
             // --- FIN NAVEGACIÓN ---
@@ -418,7 +572,7 @@ void Juego::actualizarLogica() {
             if (confirm_pressed) {
                 if (menuSelection == 0) { // REANUDAR
                     gameState = last_active_state;
-                    last_activity_time = millis(); // Actividad: Reiniciar temporizador
+                    last_activity_time = hal::millis(); // Actividad: Reiniciar temporizador
                 } else if (menuSelection == 1) { // SALIR
                     gameState = STATE_TITLE_SCREEN;
                     menuSelection = 0;
@@ -429,13 +583,13 @@ void Juego::actualizarLogica() {
 
         case STATE_GAME_OVER:
             // --- NAVEGACIÓN DEL MENÚ (Corregida con temporizador) ---
-            if ((millis() - last_menu_move_time) > MENU_MOVE_DELAY) {
+            if ((hal::millis() - last_menu_move_time) > MENU_MOVE_DELAY) {
                 if (move_up) {
                     if (menuSelection > 0) menuSelection = 0;
-                    last_menu_move_time = millis();
+                    last_menu_move_time = hal::millis();
                 } else if (move_down) {
                     if (menuSelection < 1) menuSelection = 1;
-                    last_menu_move_time = millis();
+                    last_menu_move_time = hal::millis();
                 }
             }
             // --- FIN NAVEGACIÓN ---
@@ -452,152 +606,219 @@ void Juego::actualizarLogica() {
                 }
             }
             break;
+        case STATE_CALIBRACION:
+            // menuSelection es la fase: 0 = llevar los ejes a los extremos, 1 = soltarlos al centro
+            if (confirm_pressed) {
+                if (menuSelection == 0) {
+                    menuSelection = 1;
+                } else {
+                    int cambiados = calibracion.terminar();
+                    REGISTRO_INFO("[calibracion] %d ejes calibrados", cambiados);
+                    calibracion.imprimir();
+                    gameState = STATE_TITLE_SCREEN;
+                    menuSelection = 0;
+                }
+            }
+            break;
         case STATE_IDLE:
               break;
     }
 }
 
+// --- Entrada al modo calibración ---
+// Los botones cuentan como ya presionados: hay que soltarlos antes de que
+// una pulsación avance de fase (al encender se entra con los dos apretados)
+void Juego::empezarCalibracion() {
+    calibracion.empezar();
+    gameState = STATE_CALIBRACION;
+    menuSelection = 0;
+    btn1_debounced_state = hal::NIVEL_BAJO;
+    btn2_debounced_state = hal::NIVEL_BAJO;
+    last_activity_time = hal::millis();
+    REGISTRO_INFO("[calibracion] Lleva cada eje a sus extremos, suelta y confirma");
+}
+
 // --- Tarea de Dibujo (CORE 0)
+// Solo lee la última instantánea publicada, nunca los objetos del juego
 void Juego::dibujarPantalla() {
+    const InstantaneaJuego &s = instantanea.leer();
+    latencia.alLeerInstantanea(s.traza, hal::micros());
+    if (!dibujarFrame(s)) return;
+#if PINGPONG_PERFIL
+    if (hud_activo.load(std::memory_order_relaxed)) dibujarHud();
+#endif
+    pantalla.sendBuffer();
+    // Solo cuenta si este frame cambió algo en la pantalla
+    bool hubo_envio = pantalla.diff.bytes_ultimo_frame > 0;
+    latencia.alEnviarFrame(hubo_envio);
+    if (hubo_envio) {
+        REGISTRO_TRAZA(registro::TRAZA_FRAME, (uint32_t)pantalla.diff.filas_ultimo_frame,
+                       pantalla.diff.bytes_ultimo_frame, pantalla.diff.frames);
+    }
+}
+
+// HUD en la esquina inferior derecha: FPS del dibujo y media/máximo del tick de lógica
+void Juego::dibujarHud() {
+    char hud[24];
+    const PerfilTarea::Ventana &l = perfil_logica.ventana();
+    snprintf(hud, sizeof(hud), "%ufps L%u/%uus", (unsigned)perfil_dibujo.frecuenciaHz(),
+             (unsigned)l.media_us, (unsigned)l.max_us);
+    pantalla.setDrawColor(1);
+    pantalla.setFont(hal::FUENTE_4X6);
+    pantalla.drawStr(66, 63, hud);
+}
+
+bool Juego::dibujarFrame(const InstantaneaJuego &s) {
     char score_str[5];
 
     // Si estamos en modo IDLE, solo apagamos la pantalla y salimos de la función.
-    if (gameState == STATE_IDLE) {
-        u8g2.setPowerSave(1); // Apagar pantalla
-        return;
+    if (s.gameState == STATE_IDLE) {
+        pantalla.setPowerSave(1); // Apagar pantalla
+        return false;
     }
 
     // Si no estamos en IDLE, nos aseguramos de que la pantalla esté encendida.
-    u8g2.setPowerSave(0);
+    pantalla.setPowerSave(0);
+
+    // Buffer completo: todo el frame se dibuja una sola vez y luego
+    // sendBuffer() envía solo las filas que cambiaron respecto al anterior.
+    pantalla.clearBuffer();
+    pantalla.setDrawColor(1);
 
-    u8g2.firstPage();
-    do {
-        u8g2.setDrawColor(1);
+    // --- LÓGICA DE DETECCIÓN DE PRE-APAGADO ---
+    bool show_warning = s.aviso_dormir_seg >= 0;
 
-        // --- LÓGICA DE DETECCIÓN DE PRE-APAGADO ---
-        bool show_warning = (millis() - last_activity_time) >= (INACTIVITY_TIMEOUT_MS - 3000);
+    // Si el estado es la advertencia de 3 segundos, y NO es GAME_OVER.
+    if (show_warning && s.gameState != STATE_GAME_OVER) {
 
-        // Si el estado es la advertencia de 3 segundos, y NO es GAME_OVER.
-        if (show_warning && gameState != STATE_GAME_OVER) {
+        pantalla.setFont(hal::FUENTE_7X14B);
+        pantalla.drawStr(10, 20, "AHORRO ENERGIA");
 
-            u8g2.setFont(u8g2_font_7x14B_tf);
-            u8g2.drawStr(10, 20, "AHORRO ENERGIA");
+        // Tiempo restante (calculado por la lógica)
+        int remaining_sec = s.aviso_dormir_seg;
 
-            // Calculamos el tiempo restante
-            long remaining_ms = (long)INACTIVITY_TIMEOUT_MS - (long)(millis() - last_activity_time);
-            int remaining_sec = (int)(remaining_ms / 1000);
+        if (remaining_sec > 0) {
+            char msg[30];
+            sprintf(msg, "Dormira en: %d s", remaining_sec);
+            pantalla.setFont(hal::FUENTE_7X14);
+            pantalla.drawStr(5, 40, msg);
+            pantalla.drawStr(5, 55, "Mover Joystick o boton");
+        } else {
+            pantalla.drawStr(10, 40, "Entrando a Sleep...");
+        }
 
-            if (remaining_sec > 0) {
-                char msg[30];
-                sprintf(msg, "Dormira en: %d s", remaining_sec);
-                u8g2.setFont(u8g2_font_7x14_tf);
-                u8g2.drawStr(5, 40, msg);
-                u8g2.drawStr(5, 55, "Mover Joystick o boton");
+        // Si estamos en la advertencia, no dibujamos el juego subyacente.
+        return true;
+    }
+
+    // -----------------------------------------------------------------
+    // --- Dibujo de la Lógica Principal del Juego/Menú ---
+    // -----------------------------------------------------------------
+
+    switch (s.gameState) {
+        case STATE_TITLE_SCREEN:
+            // Fuente ligeramente más grande y centrada
+            pantalla.setFont(hal::FUENTE_7X14B);
+            pantalla.drawStr(31, 20, "PING PONG");
+            pantalla.setFont(hal::FUENTE_7X14B);
+            pantalla.drawStr(10, 50, "Presiona BOTON 1");
+            break;
+        case STATE_PLAYER_SELECT:
+            pantalla.setFont(hal::FUENTE_7X14B);
+            
+            if (!s.eligiendoDificultad) {
+                pantalla.drawStr(20, 15, "MODO DE JUEGO");
+                pantalla.setFont(s.menuSelection == 0 ? hal::FUENTE_7X14B : hal::FUENTE_7X14);
+                pantalla.drawStr(30, 35, "2 JUGADORES");
+                pantalla.setFont(s.menuSelection == 1 ? hal::FUENTE_7X14B : hal::FUENTE_7X14);
+                pantalla.drawStr(30, 50, "VS MAQUINA");
             } else {
-                u8g2.drawStr(10, 40, "Entrando a Sleep...");
+                pantalla.drawStr(20, 15, "DIFICULTAD IA");
+                pantalla.setFont(s.menuSelection == 0 ? hal::FUENTE_7X14B : hal::FUENTE_7X14);
+                pantalla.drawStr(35, 30, "FACIL");
+                pantalla.setFont(s.menuSelection == 1 ? hal::FUENTE_7X14B : hal::FUENTE_7X14);
+                pantalla.drawStr(35, 45, "NORMAL");
+                pantalla.setFont(s.menuSelection == 2 ? hal::FUENTE_7X14B : hal::FUENTE_7X14);
+                pantalla.drawStr(35, 60, "DIFICIL");
             }
+            break;
+        case STATE_VS_PLAYER:
+        case STATE_VS_AI:
+            // --- PANTALLA DE JUEGO ---
+            pantalla.drawVLine(64, 0, 64); // Línea central
 
-            // Si estamos en la advertencia, no dibujamos el juego subyacente.
-            continue;
-        }
+            pantalla.setFont(hal::FUENTE_6X10);
 
-        // -----------------------------------------------------------------
-        // --- Dibujo de la Lógica Principal del Juego/Menú ---
-        // -----------------------------------------------------------------
-
-        switch (gameState) {
-            case STATE_TITLE_SCREEN:
-                // Fuente ligeramente más grande y centrada
-                u8g2.setFont(u8g2_font_7x14B_tf);
-                u8g2.drawStr(31, 20, "PING PONG");
-                u8g2.setFont(u8g2_font_7x14B_tf);
-                u8g2.drawStr(10, 50, "Presiona BOTON 1");
-                break;
-            case STATE_PLAYER_SELECT:
-                u8g2.setFont(u8g2_font_7x14B_tf);
-                
-                if (!eligiendoDificultad) {
-                    u8g2.drawStr(20, 15, "MODO DE JUEGO");
-                    u8g2.setFont(menuSelection == 0 ? u8g2_font_7x14B_tf : u8g2_font_7x14_tf);
-                    u8g2.drawStr(30, 35, "2 JUGADORES");
-                    u8g2.setFont(menuSelection == 1 ? u8g2_font_7x14B_tf : u8g2_font_7x14_tf);
-                    u8g2.drawStr(30, 50, "VS MAQUINA");
-                } else {
-                    u8g2.drawStr(20, 15, "DIFICULTAD IA");
-                    u8g2.setFont(menuSelection == 0 ? u8g2_font_7x14B_tf : u8g2_font_7x14_tf);
-                    u8g2.drawStr(35, 30, "FACIL");
-                    u8g2.setFont(menuSelection == 1 ? u8g2_font_7x14B_tf : u8g2_font_7x14_tf);
-                    u8g2.drawStr(35, 45, "NORMAL");
-                    u8g2.setFont(menuSelection == 2 ? u8g2_font_7x14B_tf : u8g2_font_7x14_tf);
-                    u8g2.drawStr(35, 60, "DIFICIL");
-                }
-                break;
-            case STATE_VS_PLAYER:
-            case STATE_VS_AI:
-                // --- PANTALLA DE JUEGO ---
-                u8g2.drawVLine(64, 0, 64); // Línea central
-
-                portENTER_CRITICAL(&scoreMux);
-                u8g2.setFont(u8g2_font_6x10_tf);
-
-                // Dibujar Puntuación P1
-                u8g2.setCursor(45, 10);
-                sprintf(score_str, "%d", score_p1);
-                u8g2.print(score_str);
-
-                // Dibujar Puntuación P2
-                u8g2.setCursor(75, 10);
-                sprintf(score_str, "%d", score_p2);
-                u8g2.print(score_str);
-                portEXIT_CRITICAL(&scoreMux);
-
-                // Dibujar objetos
-                paleta1.dibujar(u8g2);
-                paleta2.dibujar(u8g2);
-                pelota.dibujar(u8g2);
-                break;
+            // Dibujar Puntuación P1
+            pantalla.setCursor(45, 10);
+            sprintf(score_str, "%d", s.score_p1);
+            pantalla.print(score_str);
 
-            case STATE_PAUSED:
-                // --- PANTALLA DE PAUSA ---
-                u8g2.setFont(u8g2_font_7x14B_tf);
-                u8g2.drawStr(40, 15, "PAUSA");
+            // Dibujar Puntuación P2
+            pantalla.setCursor(75, 10);
+            sprintf(score_str, "%d", s.score_p2);
+            pantalla.print(score_str);
 
-                // Opciones del menú...
-                u8g2.setFont(menuSelection == 0 ? u8g2_font_7x14B_tf : u8g2_font_7x14_tf);
-                u8g2.drawStr(40, 35, "REANUDAR");
+            // Dibujar objetos
+            Paleta::dibujar(pantalla, s.paleta1_x, s.paleta1_y);
+            Paleta::dibujar(pantalla, s.paleta2_x, s.paleta2_y);
+            Pelota::dibujar(pantalla, s.pelota_x, s.pelota_y);
+            break;
 
-                u8g2.setFont(menuSelection == 1 ? u8g2_font_7x14B_tf : u8g2_font_7x14_tf);
-                u8g2.drawStr(40, 50, "SALIR");
+        case STATE_PAUSED:
+            // --- PANTALLA DE PAUSA ---
+            pantalla.setFont(hal::FUENTE_7X14B);
+            pantalla.drawStr(40, 15, "PAUSA");
 
-                u8g2.setFont(u8g2_font_4x6_tf);
-                u8g2.drawStr(0, 63, "J1/J2: Confirmar | J2: Pausa/Salir");
-                break;
+            // Opciones del menú...
+            pantalla.setFont(s.menuSelection == 0 ? hal::FUENTE_7X14B : hal::FUENTE_7X14);
+            pantalla.drawStr(40, 35, "REANUDAR");
 
-            case STATE_GAME_OVER:
-                // --- PANTALLA DE FIN DE JUEGO ---
-                u8g2.setFont(u8g2_font_7x14B_tf);
+            pantalla.setFont(s.menuSelection == 1 ? hal::FUENTE_7X14B : hal::FUENTE_7X14);
+            pantalla.drawStr(40, 50, "SALIR");
 
-                // Ganador
-                if (score_p1 >= MAX_SCORE) {
-                    u8g2.drawStr(30, 15, "GANADOR J1!");
-                } else {
-                    u8g2.drawStr(30, 15, "GANADOR J2!");
-                }
+            pantalla.setFont(hal::FUENTE_4X6);
+            pantalla.drawStr(0, 63, "J1/J2: Confirmar | J2: Pausa/Salir");
+            break;
 
-                // Opciones del menú...
-                u8g2.setFont(menuSelection == 0 ? u8g2_font_7x14B_tf : u8g2_font_7x14_tf);
-                u8g2.drawStr(40, 35, "REMATCH");
+        case STATE_GAME_OVER:
+            // --- PANTALLA DE FIN DE JUEGO ---
+            pantalla.setFont(hal::FUENTE_7X14B);
+
+            // Ganador
+            if (s.score_p1 >= MAX_SCORE) {
+                pantalla.drawStr(30, 15, "GANADOR J1!");
+            } else {
+                pantalla.drawStr(30, 15, "GANADOR J2!");
+            }
 
-                u8g2.setFont(menuSelection == 1 ? u8g2_font_7x14B_tf : u8g2_font_7x14_tf);
-                u8g2.drawStr(40, 50, "SALIR");
+            // Opciones del menú...
+            pantalla.setFont(s.menuSelection == 0 ? hal::FUENTE_7X14B : hal::FUENTE_7X14);
+            pantalla.drawStr(40, 35, "REMATCH");
 
-                u8g2.setFont(u8g2_font_4x6_tf);
-                u8g2.drawStr(0, 63, "J1/J2: Confirmar | J2: Salir");
-                break;
-            case STATE_IDLE:
-                // Ignorar
-                break;
-        }
+            pantalla.setFont(s.menuSelection == 1 ? hal::FUENTE_7X14B : hal::FUENTE_7X14);
+            pantalla.drawStr(40, 50, "SALIR");
 
-    } while ( u8g2.nextPage() );
+            pantalla.setFont(hal::FUENTE_4X6);
+            pantalla.drawStr(0, 63, "J1/J2: Confirmar | J2: Salir");
+            break;
+        case STATE_CALIBRACION:
+            pantalla.setFont(hal::FUENTE_7X14B);
+            pantalla.drawStr(8, 15, "CALIBRAR MANDOS");
+            pantalla.setFont(hal::FUENTE_6X10);
+            if (s.menuSelection == 0) {
+                pantalla.drawStr(0, 35, "Lleva cada eje a");
+                pantalla.drawStr(0, 47, "sus dos extremos");
+            } else {
+                pantalla.drawStr(0, 35, "Suelta los ejes");
+                pantalla.drawStr(0, 47, "en el centro");
+            }
+            pantalla.setFont(hal::FUENTE_4X6);
+            pantalla.drawStr(0, 63, "J1/J2: Siguiente");
+            break;
+        case STATE_IDLE:
+            // Ignorar
+            break;
+    }
+    return true;
 }
\ No newline at end of file
@@ -1,22 +1,22 @@
 #ifndef JUEGO_H
 #define JUEGO_H
 
-#include <Arduino.h>
-#include <U8g2lib.h>
+#include "Hal.h"
 #include "Paleta.h" 
 #include "Pelota.h"
-#include "freertos/FreeRTOS.h"
-#include "freertos/task.h"
-#include "driver/gpio.h" 
-#include <WiFi.h> // Necesario para ESP-NOW
-
-// --- ESTRUCTURA DE COMUNICACIÓN ESP-NOW ---
-// Enviamos la posición Y del joystick/acelerómetro (0-4095)
-typedef struct struct_message {
-    int player_id;      // 4 bytes
-    int16_t joy_y_val;  // 2 bytes
-    bool btn_pressed;   // 1 byte
-} __attribute__((packed)) AccelData_t;
+#include "TripleBuffer.h"
+#include "ColaSPSC.h"
+#include "Protocolo.h"
+#include "EstadisticasEnlace.h"
+#include "PredictorMando.h"
+#include "LatenciaMando.h"
+#include "PerfilTarea.h"
+#include "Audio.h"
+#include "Calibracion.h"
+
+// --- COMUNICACIÓN ESP-NOW ---
+// La trama del mando (versión, secuencia, marca de tiempo y eje/botón
+// empaquetados) está en comun/Protocolo/Protocolo.h, compartida con PALETA.
 
 // Declaración de los tipos de estados (necesario antes de la estructura RTC)
 typedef enum {
@@ -26,7 +26,8 @@ typedef enum {
     STATE_VS_AI,
     STATE_PAUSED, 
     STATE_GAME_OVER,
-    STATE_IDLE // NUEVO: Estado de bajo consumo/modo pasivo
+    STATE_IDLE, // NUEVO: Estado de bajo consumo/modo pasivo
+    STATE_CALIBRACION // Registro de los extremos y el centro de cada eje (Calibracion.h)
 } GameState_t;
 
 // --- ESTRUCTURA RTC RAM (Guarda el estado del juego) ---
@@ -42,21 +43,59 @@ typedef struct {
 // Variable global para almacenar el estado en la RTC RAM (definida con RTC_DATA_ATTR en main.cpp)
 extern RTC_DATA_ATTR RtcData_t rtc_game_state; 
 
-// Declaración externa de la U8g2 (definida en main.cpp)
-extern U8G2_ST7920_128X64_1_SW_SPI u8g2;
-
-// Macros de bloqueo (definida en main.cpp)
-extern portMUX_TYPE scoreMux;
-
-// --- HANDLES DE TAREAS (Para suspensión segura de FreeRTOS) ---
-extern TaskHandle_t xTaskLogicaJuegoHandle;
-extern TaskHandle_t xTaskDibujoHandle;
+// --- MUESTRAS DE LOS MANDOS REMOTOS ---
+// recibirPaquete() (callback de ESP-NOW, tarea WiFi) mete cada paquete en la
+// cola de su jugador y la tarea de lógica las vacía al inicio de cada paso.
+typedef struct {
+    uint32_t marca_ms;     // hal::millis() al recibirlo
+    uint32_t llegada_us;   // hal::micros() al recibirlo (PredictorMando)
+    uint16_t marca_emisor; // Reloj del mando, unidades de 100 us
+    uint32_t espera_us;    // Tiempo en el mando antes de salir la trama (copias redundantes)
+    int16_t joy_y_val;
+    bool btn_pressed;
+} MuestraRemota_t;
+
+// 32 muestras: 160 ms con el mando a 200 Hz, más que un periodo de la lógica en IDLE (100 ms)
+const uint32_t TAMANO_COLA_REMOTA = 32;
+
+// --- INSTANTÁNEA PARA LA TAREA DE DIBUJO ---
+// Todo lo que dibujarPantalla() necesita, copiado al final de cada paso de la
+// lógica (Core 1) y publicado por un TripleBuffer. El Core 0 dibuja solo desde
+// aquí: nunca ve un paso a medio calcular y ninguna tarea bloquea a la otra.
+// Si nada visible cambió respecto a la anterior, la tarea de dibujo no se despierta.
+struct InstantaneaJuego {
+    GameState_t gameState;
+    int menuSelection;                // En STATE_CALIBRACION, la fase
+    bool eligiendoDificultad;
+    int score_p1;
+    int score_p2;
+    int paleta1_x, paleta1_y;
+    int paleta2_x, paleta2_y;
+    int pelota_x, pelota_y;
+    int aviso_dormir_seg;             // Advertencia de ahorro de energía: -1 sin aviso, 0 entrando a Sleep
+    TrazaMuestra traza;               // Última muestra remota usada (LatenciaMando)
+};
 
 // --- CONSTANTES PARA DEEP SLEEP / INACTIVIDAD ---
 const int INACTIVITY_TIMEOUT_MS = 30000; // Tiempo de inactividad para Ahorro de Energía (30 segundos)
 // Tiempo de despertar del timer (ej: 600 segundos = 10 minutos).
 const int DEEP_SLEEP_TIMEOUT_SEC = 600; 
 
+// Periodo de la tarea de lógica en IDLE (10 Hz, en vez del paso de física)
+const int PERIODO_REPOSO_MS = 100;
+
+// Ritmo máximo de la tarea de dibujo en partida (-D PINGPONG_FPS_MAX=30).
+// Solo dibuja cuando la lógica publica una imagen distinta: en los menús, solo
+// al cambiar la selección o el estado.
+#ifndef PINGPONG_FPS_MAX
+#define PINGPONG_FPS_MAX 60
+#endif
+
+// Presupuesto por iteración de cada tarea (PerfilTarea): la lógica, un paso de
+// física; el dibujo, un frame
+const uint32_t PRESUPUESTO_LOGICA_US = 1000000UL / PINGPONG_TICK_HZ;
+const uint32_t PRESUPUESTO_DIBUJO_US = 1000000UL / PINGPONG_FPS_MAX;
+
 // Constante de la puntuación máxima
 const int MAX_SCORE = 10; 
 // Pin del Buzzer
@@ -84,27 +123,28 @@ public:
     bool eligiendoDificultad = false; // Controla si mostramos el submenú
 
     // --- VARIABLES DE COMUNICACIÓN ---
-    // Valor recibido del acelerómetro/joystick remoto (0-4095)
-    volatile int remote_joy_y_val = 2048; 
+    // Solo las toca la tarea de lógica (se llenan desde las colas remotas)
+    // Valor recibido del acelerómetro/joystick remoto (ya calibrado, 0-4095)
+    int remote_joy_y_val = 2048; 
     // Bandera que indica si se recibió un paquete recientemente (para fallback)
-    volatile bool remote_control_active = false;
+    bool remote_control_active = false;
     // Marca de tiempo del último paquete recibido
-    volatile unsigned long last_remote_packet = 0;
-    volatile bool remote_btn_pressed = false; // Estado actual del botón remoto
+    unsigned long last_remote_packet = 0;
+    bool remote_btn_pressed = false; // Estado actual del botón remoto
 
     // --- VARIABLES DE COMUNICACIÓN J2 ---
-    volatile int remote_joy_y_val_j2 = 2048; 
-    volatile bool remote_control_active_j2 = false;
-    volatile unsigned long last_remote_packet_j2 = 0;
-    volatile bool remote_btn_pressed_j2 = false;
+    int remote_joy_y_val_j2 = 2048; 
+    bool remote_control_active_j2 = false;
+    unsigned long last_remote_packet_j2 = 0;
+    bool remote_btn_pressed_j2 = false;
 
     // Variable de Detección de Actividad
     unsigned long last_activity_time; // Guarda el último momento de interacción
 
-    // Variables de Botón y Debounce (Botón 1)
-    int btn1_last_state;
-    unsigned long last_debounce_time;
-    const unsigned long debounce_delay = 50;
+    // Variables de Botón (Botón 1). El antirrebote lo hace la HAL (hal::EventoBoton);
+    // el estado "debounced" es local O remoto y sirve para detectar el flanco.
+    bool boton1_local;      // Último evento del pin local
+    bool boton2_local;
     int btn1_debounced_state;
     int btn2_debounced_state;
     bool btn1_just_pressed; // Bandera de flanco
@@ -123,15 +163,72 @@ public:
 
     // Métodos de lógica principal (llamados por las tareas de FreeRTOS)
     void logica_IA();
-    void actualizarLogica();
+    // Devuelve true si la instantánea publicada cambió algo visible (hay que redibujar)
+    bool actualizarLogica();
     void dibujarPantalla();
+
+    // Copia el estado actual a la instantánea de dibujo (lo hace actualizarLogica();
+    // llamarlo a mano solo si se cambia el estado desde fuera, p. ej. en setup()).
+    // Devuelve true si difiere de la anterior en algo que se dibuja.
+    bool publicarInstantanea();
+
+    // Callback de ESP-NOW: encola el paquete sin bloquear. Devuelve false si el
+    // paquete no es válido, es viejo/repetido o la cola de ese jugador está llena.
+    bool recibirPaquete(const uint8_t *datos, int len);
+
+    // Calidad del enlace de cada mando (las escribe recibirPaquete)
+    EstadisticasEnlace enlace_j1;
+    EstadisticasEnlace enlace_j2;
+    // Compensación de latencia de cada mando (las alimenta vaciarColasRemotas)
+    PredictorMando predictor_j1;
+    PredictorMando predictor_j2;
+    // Sonido: la lógica publica eventos y Task_Audio los toca (Audio.h)
+    Audio audio;
+
+    // Latencia mando -> pantalla por etapas (la imprime main.cpp a pedido)
+    LatenciaMando latencia;
+    // Tiempo por iteración de Task_LogicaJuego y Task_Dibujo (main.cpp)
+    PerfilTarea perfil_logica;
+    PerfilTarea perfil_dibujo;
+    // HUD de depuración sobre el frame: FPS y tiempo del tick de lógica
+    std::atomic<bool> hud_activo;
+    // Tablas de cada eje (locales y remotos) y pedido de recalibración desde
+    // otra tarea (comando serie o botones al encender, main.cpp)
+    Calibracion calibracion;
+    std::atomic<bool> calibracion_pedida;
+    // Muestras perdidas porque la cola del jugador (1 o 2) estaba llena
+    uint32_t descartesColaRemota(int jugador) const {
+        return (jugador == 1) ? cola_remota_j1.descartadosTotales() : cola_remota_j2.descartadosTotales();
+    }
+
+    // En IDLE la tarea de lógica solo revisa la actividad cada PERIODO_REPOSO_MS
+    bool enReposo() const { return gameState == STATE_IDLE; }
     
     // Método para entrar en Deep Sleep
     void entrarEnDeepSleep();
 
 private:
+    friend class Benchmark; // Mide checkInput() directamente (Benchmark.cpp)
+
     void reiniciarJuego();
     void checkInput();
+    void empezarCalibracion();
+    void procesarPaso(); // Un paso de lógica sin publicar
+    void vaciarColasRemotas();
+    void trazarMuestra(const MuestraRemota_t &m, const PredictorMando &predictor);
+    bool dibujarFrame(const InstantaneaJuego &s); // false si no hay nada que enviar (IDLE)
+    void dibujarHud();
+
+    ColaSPSC<MuestraRemota_t, TAMANO_COLA_REMOTA> cola_remota_j1;
+    ColaSPSC<MuestraRemota_t, TAMANO_COLA_REMOTA> cola_remota_j2;
+    // Última secuencia encolada por jugador (solo la usa recibirPaquete)
+    uint8_t ultima_muestra_entregada[2] = {0, 0};
+    bool hay_muestra_entregada[2] = {false, false};
+
+    TripleBuffer<InstantaneaJuego> instantanea;
+    InstantaneaJuego ultima_publicada; // Para saber si la nueva cambia algo (solo la lógica)
+    // Marcas de la última muestra remota consumida (solo la tarea de lógica)
+    TrazaMuestra traza_mando = {0, 0, 0, 0};
 };
 
 #endif // JUEGO_H
\ No newline at end of file
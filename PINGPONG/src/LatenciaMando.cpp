@@ -0,0 +1,126 @@
+// src/LatenciaMando.cpp
+
+#include "LatenciaMando.h"
+#include "Hal.h"
+
+static const char *const NOMBRES_ETAPAS[LatenciaMando::NUM_ETAPAS] = {
+    "radio*", "cola", "instantanea", "dibujo+bus", "total*"
+};
+
+// Diferencia de relojes sin signo; una estimación "del futuro" cuenta como 0
+static inline uint32_t intervaloUs(uint32_t desde_us, uint32_t hasta_us) {
+    int32_t d = (int32_t)(hasta_us - desde_us);
+    return d > 0 ? (uint32_t)d : 0;
+}
+
+// --- HistogramaLatencia ---
+
+HistogramaLatencia::HistogramaLatencia() : reinicio_pedido(false) {
+    vaciar();
+}
+
+void HistogramaLatencia::vaciar() {
+    for (int i = 0; i <= CUBETAS; i++) cubetas[i] = 0;
+    total = 0;
+    maximo_us = 0;
+    suma_us = 0;
+}
+
+void HistogramaLatencia::registrar(uint32_t us) {
+    if (reinicio_pedido.exchange(false, std::memory_order_relaxed)) vaciar();
+
+    uint32_t i = us / US_POR_CUBETA;
+    if (i > (uint32_t)CUBETAS) i = CUBETAS;
+    cubetas[i]++;
+    total++;
+    suma_us += us;
+    if (us > maximo_us) maximo_us = us;
+}
+
+uint32_t HistogramaLatencia::percentilUs(int p) const {
+    if (total == 0) return 0;
+    uint32_t objetivo = (uint32_t)(((uint64_t)total * p + 99) / 100);
+    if (objetivo == 0) objetivo = 1;
+    uint32_t acumulado = 0;
+    for (int i = 0; i < CUBETAS; i++) {
+        acumulado += cubetas[i];
+        if (acumulado >= objetivo) {
+            uint32_t limite_us = (uint32_t)(i + 1) * US_POR_CUBETA;
+            return limite_us < maximo_us ? limite_us : maximo_us;
+        }
+    }
+    return maximo_us; // Está en el desborde
+}
+
+void HistogramaLatencia::imprimir(const char *nombre, bool detalle) const {
+    hal::logf("[latencia] %-12s n %6u | p50 %6.2f ms | p90 %6.2f | p99 %6.2f | max %6.2f | media %6.2f\n",
+              nombre, (unsigned)total,
+              percentilUs(50) / 1000.0f, percentilUs(90) / 1000.0f, percentilUs(99) / 1000.0f,
+              maximo_us / 1000.0f, mediaUs() / 1000.0f);
+    if (!detalle) return;
+    for (int i = 0; i <= CUBETAS; i++) {
+        if (cubetas[i] == 0) continue;
+        if (i < CUBETAS) {
+            hal::logf("    <%6.2f ms  %u\n", (i + 1) * US_POR_CUBETA / 1000.0f, (unsigned)cubetas[i]);
+        } else {
+            hal::logf("    >=%5.2f ms  %u\n", CUBETAS * US_POR_CUBETA / 1000.0f, (unsigned)cubetas[i]);
+        }
+    }
+}
+
+// --- LatenciaMando ---
+
+LatenciaMando::LatenciaMando()
+    : ultima_leida(0),
+      leida_us(0),
+      hay_pendiente(false),
+      pendiente_enviada(false)
+{
+    pendiente.numero = 0;
+}
+
+void LatenciaMando::alConsumir(const TrazaMuestra &t) {
+    histogramas[ETAPA_RADIO].registrar(intervaloUs(t.tomada_us, t.recibida_us));
+    histogramas[ETAPA_COLA].registrar(intervaloUs(t.recibida_us, t.consumida_us));
+}
+
+void LatenciaMando::alLeerInstantanea(const TrazaMuestra &t, uint32_t ahora_us) {
+    revisarFinEnvio();
+    if (t.numero == 0 || t.numero == ultima_leida) return; // Sin muestra nueva
+    ultima_leida = t.numero;
+    histogramas[ETAPA_INSTANTANEA].registrar(intervaloUs(t.consumida_us, ahora_us));
+
+    // Si el frame de la traza anterior sigue en el bus, esta no se sigue hasta la pantalla
+    if (pendiente_enviada) return;
+    pendiente = t;
+    leida_us = ahora_us;
+    hay_pendiente = true;
+}
+
+void LatenciaMando::alEnviarFrame(bool hubo_cambios) {
+    // Un frame idéntico al anterior no muestra nada nuevo: se espera al siguiente
+    if (hay_pendiente && hubo_cambios) pendiente_enviada = true;
+    revisarFinEnvio();
+}
+
+void LatenciaMando::revisarFinEnvio() {
+    if (!pendiente_enviada) return;
+    uint32_t fin_us;
+    if (!hal::pantalla.envioTerminado(fin_us)) return;
+
+    histogramas[ETAPA_DIBUJO].registrar(intervaloUs(leida_us, fin_us));
+    histogramas[ETAPA_TOTAL].registrar(intervaloUs(pendiente.tomada_us, fin_us));
+    hay_pendiente = false;
+    pendiente_enviada = false;
+}
+
+void LatenciaMando::imprimir(bool detalle) const {
+    for (int e = 0; e < NUM_ETAPAS; e++) {
+        histogramas[e].imprimir(NOMBRES_ETAPAS[e], detalle);
+    }
+    hal::log("[latencia] * incluye el retardo de radio estimado (PINGPONG_LATENCIA_BASE_US)");
+}
+
+void LatenciaMando::reiniciar() {
+    for (int e = 0; e < NUM_ETAPAS; e++) histogramas[e].pedirReinicio();
+}
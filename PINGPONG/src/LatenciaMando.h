@@ -0,0 +1,105 @@
+// src/LatenciaMando.h
+//
+// --- LATENCIA MANDO -> PANTALLA POR ETAPAS ---
+// Cada muestra remota lleva marcas de tiempo por todo el camino y cada tramo
+// se acumula en un histograma:
+//   RADIO       mando mide -> OnDataRecv. El mando tiene otro reloj: es la
+//               espera de la muestra en el mando (copias de tramas perdidas,
+//               exacta) + el retardo de la radio estimado por PredictorMando.
+//   COLA        OnDataRecv -> la tarea de lógica la consume (actualizarLogica)
+//   INSTANTANEA consumida -> dibujarPantalla() lee la instantánea que la contiene
+//   DIBUJO      leída -> el frame terminó de salir por el bus del ST7920
+//   TOTAL       mando mide -> frame en la pantalla
+// Solo se sigue la muestra más nueva de cada paso (la que mueve la paleta).
+// RADIO y COLA las escribe la tarea de lógica; el resto, la de dibujo. La
+// lectura para imprimir no se sincroniza: puede mezclar un valor en curso.
+
+#ifndef LATENCIA_MANDO_H
+#define LATENCIA_MANDO_H
+
+#include <stdint.h>
+#include <atomic>
+
+// Marcas de una muestra remota (hal::micros() de la consola)
+struct TrazaMuestra {
+    uint32_t numero;       // 0 = ninguna muestra todavía
+    uint32_t tomada_us;    // Estimada (ver RADIO)
+    uint32_t recibida_us;
+    uint32_t consumida_us;
+};
+
+// Histograma lineal de 0 a 50 ms en cubetas de 250 us, más una de desborde
+class HistogramaLatencia {
+public:
+    static const uint32_t US_POR_CUBETA = 250;
+    static const int CUBETAS = 200;
+
+    HistogramaLatencia();
+
+    // Solo desde la tarea dueña de este histograma
+    void registrar(uint32_t us);
+
+    // Desde cualquier tarea: la dueña lo vacía en su próximo registrar()
+    void pedirReinicio() { reinicio_pedido.store(true, std::memory_order_relaxed); }
+
+    // Límite superior de la cubeta que contiene el percentil p (0-100), sin pasar del máximo
+    uint32_t percentilUs(int p) const;
+
+    uint32_t cantidad() const { return total; }
+    uint32_t maximoUs() const { return maximo_us; }
+    uint32_t mediaUs() const { return total ? (uint32_t)(suma_us / total) : 0; }
+
+    // Una línea de resumen y, con 'detalle', las cubetas no vacías
+    void imprimir(const char *nombre, bool detalle) const;
+
+private:
+    void vaciar();
+
+    uint32_t cubetas[CUBETAS + 1];
+    uint32_t total;
+    uint32_t maximo_us;
+    uint64_t suma_us;
+    std::atomic<bool> reinicio_pedido;
+};
+
+class LatenciaMando {
+public:
+    enum Etapa {
+        ETAPA_RADIO,
+        ETAPA_COLA,
+        ETAPA_INSTANTANEA,
+        ETAPA_DIBUJO,
+        ETAPA_TOTAL,
+        NUM_ETAPAS
+    };
+
+    LatenciaMando();
+
+    // --- Tarea de lógica: la muestra más nueva del paso ya se usó ---
+    void alConsumir(const TrazaMuestra &t);
+
+    // --- Tarea de dibujo ---
+    // Al leer la instantánea y después de pantalla.sendBuffer()
+    void alLeerInstantanea(const TrazaMuestra &t, uint32_t ahora_us);
+    void alEnviarFrame(bool hubo_cambios);
+
+    // --- Cualquier tarea (consola serie) ---
+    void imprimir(bool detalle) const;
+    void reiniciar();
+
+    const HistogramaLatencia &etapa(Etapa e) const { return histogramas[e]; }
+
+private:
+    void revisarFinEnvio();
+
+    HistogramaLatencia histogramas[NUM_ETAPAS];
+
+    // Traza esperando a que su frame termine de salir (solo la tarea de dibujo)
+    uint32_t ultima_leida;
+    TrazaMuestra pendiente;
+    uint32_t leida_us;
+    bool hay_pendiente;
+    bool pendiente_enviada;
+};
+
+#endif // LATENCIA_MANDO_H
@@ -0,0 +1,56 @@
+// src/MedidorJitter.cpp
+
+#include "MedidorJitter.h"
+#include "Hal.h"
+
+static const uint32_t US_POR_VENTANA = 1000000;
+
+MedidorJitter::MedidorJitter(uint32_t periodo)
+    : periodo_us(periodo),
+      hay_previo(false),
+      previo_us(0),
+      inicio_ventana_us(0),
+      despertares(0),
+      suma_desvio_us(0),
+      max_desvio_us(0),
+      fuera(0)
+{
+    ultima.despertares = 0;
+    ultima.desvio_medio_us = 0;
+    ultima.desvio_max_us = 0;
+    ultima.fuera_de_tolerancia = 0;
+}
+
+void MedidorJitter::registrar(uint32_t ahora_us) {
+    if (hay_previo) {
+        int32_t desvio = (int32_t)(ahora_us - previo_us - periodo_us);
+        uint32_t d = desvio < 0 ? (uint32_t)(-desvio) : (uint32_t)desvio;
+        despertares++;
+        suma_desvio_us += d;
+        if (d > max_desvio_us) max_desvio_us = d;
+        if (d > periodo_us / 10) fuera++;
+    } else {
+        inicio_ventana_us = ahora_us;
+    }
+    hay_previo = true;
+    previo_us = ahora_us;
+
+    if (ahora_us - inicio_ventana_us >= US_POR_VENTANA) {
+        ultima.despertares = despertares;
+        ultima.desvio_medio_us = despertares ? (uint32_t)(suma_desvio_us / despertares) : 0;
+        ultima.desvio_max_us = max_desvio_us;
+        ultima.fuera_de_tolerancia = fuera;
+        inicio_ventana_us = ahora_us;
+        despertares = 0;
+        suma_desvio_us = 0;
+        max_desvio_us = 0;
+        fuera = 0;
+    }
+}
+
+void MedidorJitter::imprimir(const char *origen) const {
+    hal::logf("[tick] %s, periodo %u us | desvio medio %u us | max %u us | >10%%: %u de %u\n",
+              origen, (unsigned)periodo_us, (unsigned)ultima.desvio_medio_us,
+              (unsigned)ultima.desvio_max_us, (unsigned)ultima.fuera_de_tolerancia,
+              (unsigned)ultima.despertares);
+}
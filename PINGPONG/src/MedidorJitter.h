@@ -0,0 +1,47 @@
+// src/MedidorJitter.h
+//
+// --- JITTER DEL TICK DE LÓGICA ---
+// registrar() en cada despertar de Task_LogicaJuego: compara el tiempo desde
+// el despertar anterior con el periodo del paso. Cada segundo cierra una
+// ventana con el desvío medio y máximo y cuántos despertares se desviaron más
+// de un 10% del periodo. Solo escribe la tarea de lógica; el informe serie lee
+// la última ventana sin cerrojos (como PerfilTarea).
+
+#ifndef MEDIDOR_JITTER_H
+#define MEDIDOR_JITTER_H
+
+#include <stdint.h>
+
+class MedidorJitter {
+public:
+    struct Ventana {
+        uint32_t despertares;
+        uint32_t desvio_medio_us;
+        uint32_t desvio_max_us;
+        uint32_t fuera_de_tolerancia;
+    };
+
+    explicit MedidorJitter(uint32_t periodo_us);
+
+    // El próximo despertar no se compara (arranque o salida de IDLE)
+    void reiniciar() { hay_previo = false; }
+
+    void registrar(uint32_t ahora_us);
+
+    const Ventana &ventana() const { return ultima; }
+
+    void imprimir(const char *origen) const;
+
+private:
+    uint32_t periodo_us;
+    bool hay_previo;
+    uint32_t previo_us;
+    uint32_t inicio_ventana_us;
+    uint32_t despertares;
+    uint64_t suma_desvio_us;
+    uint32_t max_desvio_us;
+    uint32_t fuera;
+    Ventana ultima;
+};
+
+#endif // MEDIDOR_JITTER_H
@@ -5,42 +5,52 @@
 // --- Constructor ---
 Paleta::Paleta(int start_x) {
     x = start_x;
-    // Inicializamos tanto la Y entera como la flotante en el centro
+    // Inicializamos tanto la Y entera como la precisa en el centro
     y = (64 / 2) - (ALTO / 2);
-    y_float = (float)y; 
+    y_precisa = y; 
+}
+
+// --- Joystick (0-4095) -> Y objetivo (0 a 64-ALTO) ---
+// Sustituye a map(), que hacía una división entera en cada tick.
+static inline Escalar objetivoDesdeJoystick(int joy_val) {
+    const int RECORRIDO = 64 - Paleta::ALTO;
+#if PINGPONG_FISICA_FIJA
+    // RECORRIDO/4095 en Q16.16 con 12 bits extra: una multiplicación y un desplazamiento
+    const int64_t FACTOR = (((int64_t)RECORRIDO << (Fijo::BITS_FRACCION + 12)) + 2047) / 4095;
+    return Fijo::desdeRaw((int32_t)(((int64_t)joy_val * FACTOR + (1 << 11)) >> 12));
+#else
+    return joy_val * (RECORRIDO / 4095.0f);
+#endif
 }
 
 // --- Método de Actualización de Posición con Suavizado ---
-void Paleta::actualizarPosicion(int joy_val) {
+void Paleta::actualizarPosicion(int joy_val, bool filtrado) {
     
-    // 1. MITIGACIÓN DE RUIDO
-    if (joy_val < 50) { 
-        joy_val = 0; 
-    } else if (joy_val > 4045) {
-        joy_val = 4095;
-    }
-
-    // 2. Cálculo del OBJETIVO (Target)
+    // 1. Cálculo del OBJETIVO (Target)
+    // (La saturación de los extremos ya la aplicó la tabla de calibración)
     // Calculamos a dónde debería ir la paleta según el joystick
-    float target_y = map(joy_val, 0, 4095, 0, 64 - ALTO); 
+    Escalar target_y = objetivoDesdeJoystick(joy_val); 
 
-    // 3. LÓGICA DE SUAVIZADO (Lerp)
+    // 2. LÓGICA DE SUAVIZADO (Lerp)
     // Definimos una constante de suavizado (0.1 significa que se mueve el 10% de la distancia restante)
     // Puedes ajustar este valor: 0.05 es muy lento/suave, 0.20 es más rápido.
-    const float SUAVIZADO = 0.12f; 
+    // (Valor por tick de 200 Hz, convertido al paso de física configurado)
+    constexpr Escalar SUAVIZADO = escalarDe(suavizadoPorPaso(0.12)); 
+    // Mando remoto: la señal ya llega limpia, solo se alisa el paso entre paquetes
+    constexpr Escalar SUAVIZADO_FILTRADO = escalarDe(suavizadoPorPaso(0.5));
     
     // La paleta "persigue" al objetivo
-    y_float = y_float + (target_y - y_float) * SUAVIZADO;
+    y_precisa = y_precisa + (target_y - y_precisa) * (filtrado ? SUAVIZADO_FILTRADO : SUAVIZADO);
 
-    // 4. Convertimos a entero para el dibujo en pantalla
-    y = (int)y_float;
+    // 3. Convertimos a entero para el dibujo en pantalla
+    y = escalarAEntero(y_precisa);
 
-    // 5. Limitar posición
-    y = constrain(y, 0, 64 - ALTO);
-    y_float = constrain(y_float, 0.0f, (float)(64 - ALTO));
+    // 4. Limitar posición
+    y = hal::limitar(y, 0, 64 - ALTO);
+    y_precisa = hal::limitar(y_precisa, Escalar(0), Escalar(64 - ALTO));
 }
 
 // --- Método de Dibujo ---
-void Paleta::dibujar(U8G2 &u8g2) {
-    u8g2.drawBox(x, y, ANCHO, ALTO);
+void Paleta::dibujar(hal::Pantalla &pantalla, int x, int y) {
+    pantalla.drawBox(x, y, ANCHO, ALTO);
 }
\ No newline at end of file
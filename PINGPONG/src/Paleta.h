@@ -1,28 +1,33 @@
 #ifndef PALETA_H
 #define PALETA_H
 
-#include <U8g2lib.h>
-#include <Arduino.h>
+#include "Hal.h"
+#include "Fijo.h"
+#include "PasoFijo.h"
 
 class Paleta {
 public:
     // Constantes de tamaño
-    const int ANCHO = 3;
-    const int ALTO = 15;
+    static constexpr int ANCHO = 3;
+    static constexpr int ALTO = 15;
 
     // Variables de posición
     int x;
     int y;
-    float y_float; // Para cálculos de movimiento fluido
+    Escalar y_precisa; // Posición con fracción (Q16.16) para el movimiento fluido
 
     // Constructor
     Paleta(int start_x); 
     
     // Método para actualizar la posición basado en el joystick o remoto
-    void actualizarPosicion(int joy_val); 
+    // (joy_val ya en la escala normalizada de Calibracion.h).
+    // 'filtrado': el valor viene de un mando que ya filtra su inclinación
+    // (giroscopio + acelerómetro), así que se suaviza mucho menos.
+    void actualizarPosicion(int joy_val, bool filtrado = false); 
     
-    // Método para dibujar (recibe la referencia al objeto u8g2)
-    void dibujar(U8G2 &u8g2);
+    // Dibuja una paleta en (x, y). Es estático porque la tarea de dibujo usa
+    // la posición de la instantánea publicada, no la de este objeto (Juego.h)
+    static void dibujar(hal::Pantalla &pantalla, int x, int y);
 };
 
 #endif // PALETA_H
\ No newline at end of file
@@ -0,0 +1,50 @@
+// src/PasoFijo.cpp
+
+#include "PasoFijo.h"
+
+PasoFijo::PasoFijo(uint32_t hz, int max_pasos)
+    : pasos_simulados(0),
+      pasos_descartados(0),
+      iteraciones_con_recuperacion(0),
+      periodo_us(1000000UL / hz),
+      max_pasos(max_pasos),
+      ultimo_us(0),
+      acumulado_us(0)
+{
+}
+
+void PasoFijo::reiniciar(uint32_t ahora_us) {
+    ultimo_us = ahora_us;
+    acumulado_us = 0;
+}
+
+int PasoFijo::pasosPendientes(uint32_t ahora_us) {
+    // Resta sin signo: correcta aunque micros() dé la vuelta
+    acumulado_us += ahora_us - ultimo_us;
+    ultimo_us = ahora_us;
+
+    int pasos = (int)(acumulado_us / periodo_us);
+    if (pasos > max_pasos) {
+        pasos_descartados += (uint32_t)(pasos - max_pasos);
+        pasos = max_pasos;
+        acumulado_us = 0; // Se pierde el sobrante: la física se frena en vez de saltar
+    } else {
+        acumulado_us -= (uint32_t)pasos * periodo_us;
+    }
+
+    if (pasos > 1) iteraciones_con_recuperacion++;
+    pasos_simulados += (uint32_t)pasos;
+    return pasos;
+}
+
+int PasoFijo::pasosPorTicks(uint32_t ticks) {
+    int pasos = (int)ticks;
+    if (ticks > (uint32_t)max_pasos) {
+        pasos_descartados += ticks - (uint32_t)max_pasos;
+        pasos = max_pasos;
+    }
+
+    if (pasos > 1) iteraciones_con_recuperacion++;
+    pasos_simulados += (uint32_t)pasos;
+    return pasos;
+}
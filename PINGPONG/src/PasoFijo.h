@@ -0,0 +1,89 @@
+// src/PasoFijo.h
+//
+// --- PASO FIJO DE SIMULACIÓN (ACUMULADOR) ---
+// La física avanza siempre en pasos de 1/PINGPONG_TICK_HZ segundos, sin importar
+// cuánto tardó cada iteración de la tarea. El tiempo real transcurrido se suma a
+// un acumulador y se simulan tantos pasos como quepan, con un máximo por
+// iteración para que una sobrecarga no provoque una espiral de recuperación.
+
+#ifndef PASO_FIJO_H
+#define PASO_FIJO_H
+
+#include <stdint.h>
+
+// Frecuencia de la física: 200, 500 o 1000 Hz (-D PINGPONG_TICK_HZ=500).
+// Con la colisión por barrido de Pelota también sirven frecuencias menores
+// (p. ej. 100 Hz): la pelota no atraviesa las paletas aunque avance varios px por paso.
+#ifndef PINGPONG_TICK_HZ
+#define PINGPONG_TICK_HZ 200
+#endif
+
+// Máximo de pasos que se recuperan en una sola iteración de la tarea
+#ifndef PINGPONG_MAX_PASOS_RECUPERACION
+#define PINGPONG_MAX_PASOS_RECUPERACION 4
+#endif
+
+// Las constantes de la física (velocidades de la pelota, suavizados de las
+// paletas) se ajustaron con el tick original de 200 Hz. Estas funciones las
+// convierten al paso configurado; se evalúan en compilación.
+const int TICK_HZ_REFERENCIA = 200;
+
+namespace paso_fijo_detalle {
+// ln(x) = 2 * atanh((x - 1) / (x + 1)), serie para 0 < x <= 1
+constexpr double lnSerie(double z, double z2, double termino, int k) {
+    return k > 60 ? 0.0 : termino / (2 * k + 1) + lnSerie(z, z2, termino * z2, k + 1);
+}
+constexpr double ln(double x) {
+    return 2.0 * lnSerie((x - 1) / (x + 1), ((x - 1) / (x + 1)) * ((x - 1) / (x + 1)), (x - 1) / (x + 1), 0);
+}
+// exp(x) por serie de Taylor (|x| pequeño)
+constexpr double expSerie(double x, double termino, int k) {
+    return k > 40 ? 0.0 : termino + expSerie(x, termino * x / (k + 1), k + 1);
+}
+constexpr double exp(double x) { return expSerie(x, 1.0, 0); }
+} // namespace paso_fijo_detalle
+
+// Velocidad en pixeles por tick de 200 Hz -> pixeles por paso
+constexpr double velocidadPorPaso(double por_tick_referencia) {
+    return por_tick_referencia * TICK_HZ_REFERENCIA / PINGPONG_TICK_HZ;
+}
+
+// Factor de lerp por tick de 200 Hz -> factor por paso que converge igual de
+// rápido en tiempo real: 1 - (1 - f)^(200 / Hz)
+constexpr double suavizadoPorPaso(double f) {
+    return 1.0 - paso_fijo_detalle::exp(paso_fijo_detalle::ln(1.0 - f) *
+                                         TICK_HZ_REFERENCIA / PINGPONG_TICK_HZ);
+}
+
+class PasoFijo {
+public:
+    explicit PasoFijo(uint32_t hz = PINGPONG_TICK_HZ,
+                      int max_pasos = PINGPONG_MAX_PASOS_RECUPERACION);
+
+    // Descarta el tiempo acumulado (arranque o salida de IDLE)
+    void reiniciar(uint32_t ahora_us);
+
+    // Suma el tiempo transcurrido desde la última llamada y devuelve cuántos
+    // pasos simular ahora (0..max_pasos). Si el retraso supera el máximo, el
+    // sobrante se descarta y se cuenta en pasos_descartados.
+    int pasosPendientes(uint32_t ahora_us);
+
+    // Con un temporizador que avisa cada periodo: 'ticks' vencidos desde la
+    // última llamada -> pasos a simular, con el mismo máximo y estadísticas
+    int pasosPorTicks(uint32_t ticks);
+
+    uint32_t periodoUs() const { return periodo_us; }
+
+    // Estadísticas
+    uint32_t pasos_simulados;
+    uint32_t pasos_descartados;
+    uint32_t iteraciones_con_recuperacion; // Iteraciones que simularon más de un paso
+
+private:
+    uint32_t periodo_us;
+    int max_pasos;
+    uint32_t ultimo_us;
+    uint32_t acumulado_us;
+};
+
+#endif // PASO_FIJO_H
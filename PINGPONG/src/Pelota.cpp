@@ -1,18 +1,15 @@
 #include "Pelota.h"
 #include "Paleta.h"
-#include "Juego.h" // Necesario para acceder a PIN_BUZZER
 
-// --- Función auxiliar para emitir un sonido corto ---
-// Utiliza PIN_BUZZER que está definido en Juego.h
-void playSound(int freq, int duration_ms) {
-    // Usamos tone() y noTone() para el buzzer
-    tone(PIN_BUZZER, freq, duration_ms);
+// --- Sonido: la física solo publica el evento (Audio.h lo toca en su tarea) ---
+void Pelota::sonar(Audio::Evento e) {
+    if (audio != nullptr) audio->publicar(e);
 }
 
 
 // --- Constructor ---
+// La semilla la fija quien arranca el juego (main.cpp / main_native.cpp)
 Pelota::Pelota() {
-    randomSeed(analogRead(34)); 
     reiniciar();
 }
 
@@ -21,89 +18,165 @@ void Pelota::reiniciar() {
     x = 128 / 2; 
     y = 64 / 2;
 
+    // Los rangos están expresados en píxeles por tick de 200 Hz y se convierten
+    // al paso configurado (PasoFijo.h): la velocidad en pantalla no cambia con PINGPONG_TICK_HZ.
+
     // VELOCIDAD HORIZONTAL: AJUSTE A RANGO (0.2 a 0.5 píxeles por ciclo)
-    float vel_x_base = 0.2; 
-    float vel_x_rand = (float)random(0, 10) / 10.0 * 0.3; 
+    // (aleatorio(0, 10) / 10.0 * 0.3 == aleatorio(0, 10) * 3 / 100, sin FPU)
+    constexpr Escalar vel_x_base = escalarDe(velocidadPorPaso(0.2)); 
+    Escalar vel_x_rand = escalarFraccion(hal::aleatorio(0, 10) * 3 * TICK_HZ_REFERENCIA, 100 * PINGPONG_TICK_HZ); 
 
     // VELOCIDAD VERTICAL: AJUSTE A RANGO (0.1 a 0.4 píxeles por ciclo)
-    float vel_y_base = 0.1; 
-    float vel_y_rand = (float)random(0, 10) / 10.0 * 0.3; 
+    constexpr Escalar vel_y_base = escalarDe(velocidadPorPaso(0.1)); 
+    Escalar vel_y_rand = escalarFraccion(hal::aleatorio(0, 10) * 3 * TICK_HZ_REFERENCIA, 100 * PINGPONG_TICK_HZ); 
 
     // La velocidad final X estará entre 0.2 y 0.5
-    velocidad_x = (random(0, 2) == 0) ? -(vel_x_base + vel_x_rand) : (vel_x_base + vel_x_rand); 
+    velocidad_x = (hal::aleatorio(0, 2) == 0) ? -(vel_x_base + vel_x_rand) : (vel_x_base + vel_x_rand); 
     
     // La velocidad final Y estará entre 0.1 y 0.4
-    velocidad_y = (random(0, 2) == 0) ? -(vel_y_base + vel_y_rand) : (vel_y_base + vel_y_rand); 
+    velocidad_y = (hal::aleatorio(0, 2) == 0) ? -(vel_y_base + vel_y_rand) : (vel_y_base + vel_y_rand); 
 }
 
 // --- Lógica de Actualización Principal ---
+// Movimiento con detección continua (barrido): en vez de mover la pelota y
+// revisar si quedó encima de una paleta, se calcula el instante exacto del
+// primer impacto dentro del paso, se avanza hasta ahí, se refleja la velocidad
+// y se consume el tiempo restante con la nueva dirección. Así la pelota no
+// atraviesa la paleta de 3 px aunque avance varios píxeles por paso.
 void Pelota::actualizar(Paleta &p1, Paleta &p2, int &s1, int &s2) { 
-    // 1. Mover la pelota
-    x += velocidad_x;
-    y += velocidad_y;
+    Escalar restante = 1; // Fracción del paso que falta por simular
 
-    // 2. Verificar colisiones de bordes
-    verificarColisionBordes();
-    
-    // 3. Verificar colisiones de paleta
-    verificarColisionPaleta(p1, p2); 
+    for (int rebote = 0; rebote < MAX_REBOTES_POR_PASO; rebote++) {
+        // 1. Buscar el primer impacto del segmento restante
+        Impacto imp = { IMPACTO_NINGUNO, restante };
+        verificarColisionBordes(restante, imp);
+        verificarColisionPaleta(p1, p2, restante, imp);
+
+        // 2. Mover la pelota hasta el impacto (o hasta el final del paso)
+        x += velocidad_x * imp.t;
+        y += velocidad_y * imp.t;
+        restante -= imp.t;
+
+        if (imp.tipo == IMPACTO_NINGUNO) break;
+
+        // 3. Reflejar la componente de la velocidad según la superficie
+        if (imp.tipo == IMPACTO_BORDE || imp.tipo == IMPACTO_PALETA_CANTO) {
+            velocidad_y = -velocidad_y;
+        } else {
+            velocidad_x = -velocidad_x;
+        }
+
+        if (imp.tipo == IMPACTO_BORDE) {
+            sonar(Audio::EVENTO_BORDE); // SONIDO: BORDE (Agudo y corto)
+        } else {
+            sonar(Audio::EVENTO_PALETA); // SONIDO: PALETA (Medio y corto)
+        }
+    }
 
     // 4. Verificar si se salió del campo (Puntuación)
     if (x < 0) {
         s2++; 
         reiniciar();
-        playSound(100, 200); // SONIDO: PUNTO GRAVE Y LARGO
+        sonar(Audio::EVENTO_PUNTO); // SONIDO: PUNTO GRAVE Y LARGO
     }
     
     if (x > 128 - TAMANO) {
         s1++;
         reiniciar();
-        playSound(100, 200); // SONIDO: PUNTO GRAVE Y LARGO
+        sonar(Audio::EVENTO_PUNTO); // SONIDO: PUNTO GRAVE Y LARGO
     }
 }
 
 // --- Colisión con Bordes Superiores/Inferiores ---
-void Pelota::verificarColisionBordes() {
-    if (y <= 0) {
-        velocidad_y = -velocidad_y;
-        playSound(880, 50); // SONIDO: BORDE SUPERIOR (Agudo y corto)
+void Pelota::verificarColisionBordes(Escalar restante, Impacto &imp) {
+    Escalar y_final = y + velocidad_y * restante;
+    Escalar t;
+
+    if (velocidad_y < 0 && y_final < 0) {
+        t = (y > 0) ? (Escalar(0) - y) / velocidad_y : Escalar(0);
+    } else if (velocidad_y > 0 && y_final > 64 - TAMANO) {
+        t = (y < 64 - TAMANO) ? (Escalar(64 - TAMANO) - y) / velocidad_y : Escalar(0);
+    } else {
+        return;
     }
-    if (y >= 64 - TAMANO) {
-        velocidad_y = -velocidad_y;
-        playSound(880, 50); // SONIDO: BORDE INFERIOR (Agudo y corto)
+
+    if (t < imp.t) {
+        imp.tipo = IMPACTO_BORDE;
+        imp.t = t;
     }
 }
 
-// --- Colisión con Paletas (DEFINICIÓN DE LA FUNCIÓN CORREGIDA) ---
-void Pelota::verificarColisionPaleta(Paleta &p1, Paleta &p2) {
-    // Colisión con Paleta 1 (Izquierda)
-    if (x <= p1.x + p1.ANCHO && 
-        x >= p1.x &&
-        // VERIFICACIÓN DE SUPERPOSICIÓN Y
-        (y + TAMANO) >= p1.y && 
-        y <= (p1.y + p1.ALTO) && 
-        // FIN VERIFICACIÓN DE SUPERPOSICIÓN Y
-        velocidad_x < 0) 
-    {
-        velocidad_x = -velocidad_x;
-        playSound(440, 50); // SONIDO: PALETA (Medio y corto)
+// --- Colisión con Paletas (barrido segmento vs. caja) ---
+void Pelota::verificarColisionPaleta(const Paleta &p1, const Paleta &p2, Escalar restante, Impacto &imp) {
+    // Solo cuenta la paleta hacia la que se mueve la pelota:
+    // Paleta 1 (Izquierda) si va a la izquierda, Paleta 2 (Derecha) si va a la derecha.
+    if (velocidad_x < 0) {
+        barridoPaleta(p1, restante, imp);
+    } else if (velocidad_x > 0) {
+        barridoPaleta(p2, restante, imp);
     }
-    
-    // Colisión con Paleta 2 (Derecha)
-    if (x >= p2.x - TAMANO && 
-        x <= p2.x + p2.ANCHO && 
-        // VERIFICACIÓN DE SUPERPOSICIÓN Y
-        (y + TAMANO) >= p2.y && 
-        y <= p2.y + p2.ALTO &&
-        // FIN VERIFICACIÓN DE SUPERPOSICIÓN Y
-        velocidad_x > 0) 
-    {
-        velocidad_x = -velocidad_x;
-        playSound(440, 50); // SONIDO: PALETA (Medio y corto)
+}
+
+// Método de las "losas": la esquina superior izquierda de la pelota contra la
+// paleta ampliada por el tamaño de la pelota (suma de Minkowski). Devuelve
+// true si guardó un impacto anterior al que ya tenía 'imp'.
+bool Pelota::barridoPaleta(const Paleta &p, Escalar restante, Impacto &imp) {
+    const int caja_x0 = p.x - TAMANO;
+    const int caja_x1 = p.x + p.ANCHO;
+    const int caja_y0 = p.y - TAMANO;
+    const int caja_y1 = p.y + p.ALTO;
+
+    // 1. Descarte rápido: la caja del segmento no toca la paleta (caso común, sin divisiones)
+    Escalar x_final = x + velocidad_x * restante;
+    Escalar y_final = y + velocidad_y * restante;
+    Escalar seg_x0 = (x < x_final) ? x : x_final;
+    Escalar seg_x1 = (x < x_final) ? x_final : x;
+    Escalar seg_y0 = (y < y_final) ? y : y_final;
+    Escalar seg_y1 = (y < y_final) ? y_final : y;
+    if (seg_x1 < caja_x0 || seg_x0 > caja_x1 || seg_y1 < caja_y0 || seg_y0 > caja_y1) {
+        return false;
+    }
+
+    // 2. Intervalo de entrada/salida en X (velocidad_x nunca es 0 aquí)
+    Escalar tx_entrada = (Escalar(velocidad_x > 0 ? caja_x0 : caja_x1) - x) / velocidad_x;
+    Escalar tx_salida = (Escalar(velocidad_x > 0 ? caja_x1 : caja_x0) - x) / velocidad_x;
+
+    // 3. Intervalo de entrada/salida en Y
+    Escalar ty_entrada, ty_salida;
+    if (velocidad_y == 0) {
+        if (y < caja_y0 || y > caja_y1) return false;
+        ty_entrada = tx_entrada; // No limita: la entrada la decide X
+        ty_salida = tx_salida;
+    } else {
+        ty_entrada = (Escalar(velocidad_y > 0 ? caja_y0 : caja_y1) - y) / velocidad_y;
+        ty_salida = (Escalar(velocidad_y > 0 ? caja_y1 : caja_y0) - y) / velocidad_y;
+    }
+
+    Escalar t_entrada = (tx_entrada > ty_entrada) ? tx_entrada : ty_entrada;
+    Escalar t_salida = (tx_salida < ty_salida) ? tx_salida : ty_salida;
+
+    // t_salida == 0: toca la caja pero ya se aleja (recién rebotada en el canto)
+    if (t_entrada > t_salida || t_salida <= 0 || t_entrada > restante) {
+        return false;
+    }
+
+    // Si ya estaba dentro (la paleta se movió sobre la pelota) rebota ahora,
+    // igual que la detección por superposición original.
+    TipoImpacto tipo = (tx_entrada >= ty_entrada) ? IMPACTO_PALETA_FRENTE : IMPACTO_PALETA_CANTO;
+    if (t_entrada < 0) {
+        t_entrada = 0;
+        tipo = IMPACTO_PALETA_FRENTE;
+    }
+
+    if (t_entrada < imp.t) {
+        imp.tipo = tipo;
+        imp.t = t_entrada;
+        return true;
     }
+    return false;
 }
 
 // --- Dibujo ---
-void Pelota::dibujar(U8G2 &u8g2) {
-    u8g2.drawBox((int)x, (int)y, TAMANO, TAMANO);
+void Pelota::dibujar(hal::Pantalla &pantalla, int x, int y) {
+    pantalla.drawBox(x, y, TAMANO, TAMANO);
 }
\ No newline at end of file
@@ -3,17 +3,20 @@
 #ifndef PELOTA_H
 #define PELOTA_H
 
-#include <U8g2lib.h>
-#include <Arduino.h>
+#include "Hal.h"
+#include "Fijo.h"
+#include "PasoFijo.h"
 #include "Paleta.h" // Incluir Paleta para la lógica de colisión
+#include "Audio.h"
 
 class Pelota {
 public:
-    const int TAMANO = 3;
-    float x;
-    float y;
-    float velocidad_x;
-    float velocidad_y;
+    static constexpr int TAMANO = 3;
+    // Posición y velocidad en pixeles (por paso de física) con fracción: Q16.16 por defecto (Fijo.h)
+    Escalar x;
+    Escalar y;
+    Escalar velocidad_x;
+    Escalar velocidad_y;
 
     // Constructor
     Pelota(); 
@@ -21,12 +24,33 @@ public:
     // Métodos
     // En Pelota.h
     void actualizar(Paleta &p1, Paleta &p2, int &s1, int &s2);
-    void dibujar(U8G2 &u8g2);
+    static void dibujar(hal::Pantalla &pantalla, int x, int y); // Posición de la instantánea (Juego.h)
     void reiniciar();
 
+    // Cola de sonido donde publicar rebotes y puntos (sin ella, la pelota es muda)
+    void conectarAudio(Audio *a) { audio = a; }
+
 private:
-    void verificarColisionBordes();
-    void verificarColisionPaleta(Paleta &p1, Paleta &p2);
+    friend class Benchmark; // Mide verificarColisionPaleta() directamente (Benchmark.cpp)
+
+    // Máximo de rebotes resueltos dentro de un mismo paso
+    static const int MAX_REBOTES_POR_PASO = 4;
+
+    // Primer impacto encontrado por el barrido del paso actual
+    enum TipoImpacto { IMPACTO_NINGUNO, IMPACTO_BORDE, IMPACTO_PALETA_FRENTE, IMPACTO_PALETA_CANTO };
+    struct Impacto {
+        TipoImpacto tipo;
+        Escalar t; // Fracción del paso (0..1) en la que ocurre
+    };
+
+    // Detección continua: buscan el primer impacto del segmento
+    // (x, y) -> (x, y) + velocidad * restante, y lo guardan en 'imp' si es anterior.
+    void verificarColisionBordes(Escalar restante, Impacto &imp);
+    void verificarColisionPaleta(const Paleta &p1, const Paleta &p2, Escalar restante, Impacto &imp);
+    bool barridoPaleta(const Paleta &p, Escalar restante, Impacto &imp);
+
+    void sonar(Audio::Evento e);
+    Audio *audio = nullptr;
 };
 
 #endif // PELOTA_H
\ No newline at end of file
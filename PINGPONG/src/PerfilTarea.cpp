@@ -0,0 +1,59 @@
+// src/PerfilTarea.cpp
+
+#include "PerfilTarea.h"
+
+PerfilTarea::PerfilTarea(uint32_t presupuesto)
+    : presupuesto_us(presupuesto),
+      presupuesto_ciclos(0),
+      ciclos_inicio(0),
+      inicio_ventana_us(0),
+      iteraciones(0),
+      suma_ciclos(0),
+      max_ciclos(0),
+      excesos(0),
+      excesos_totales(0)
+{
+    ultima.iteraciones = 0;
+    ultima.media_us = 0;
+    ultima.max_us = 0;
+    ultima.excesos = 0;
+    ultima.ocupacion_pormil = 0;
+    ultima.duracion_ms = 0;
+}
+
+void PerfilTarea::cerrarVentana(uint32_t ahora_us) {
+    uint32_t duracion_us = ahora_us - inicio_ventana_us;
+    inicio_ventana_us = ahora_us;
+    // La primera ventana empieza con el reloj en 0: no es representativa
+    if (duracion_us > 2 * US_POR_VENTANA) {
+        iteraciones = 0;
+        suma_ciclos = 0;
+        max_ciclos = 0;
+        excesos = 0;
+        return;
+    }
+
+    uint32_t ciclos_por_us = hal::ciclosPorSegundo() / 1000000;
+    if (ciclos_por_us == 0) ciclos_por_us = 1;
+    uint64_t ocupado_us = suma_ciclos / ciclos_por_us;
+
+    ultima.iteraciones = iteraciones;
+    ultima.media_us = iteraciones ? (uint32_t)(ocupado_us / iteraciones) : 0;
+    ultima.max_us = max_ciclos / ciclos_por_us;
+    ultima.excesos = excesos;
+    ultima.ocupacion_pormil = (uint32_t)(ocupado_us * 1000 / duracion_us);
+    ultima.duracion_ms = duracion_us / 1000;
+
+    iteraciones = 0;
+    suma_ciclos = 0;
+    max_ciclos = 0;
+    excesos = 0;
+}
+
+void PerfilTarea::imprimir(const char *nombre) const {
+    const Ventana &v = ultima;
+    hal::logf("[perfil] %-11s %4u Hz | media %5u us | max %5u | presup. %5u us, excesos %u (total %u) | ocupa %u.%u%%\n",
+              nombre, (unsigned)frecuenciaHz(), (unsigned)v.media_us, (unsigned)v.max_us,
+              (unsigned)presupuesto_us, (unsigned)v.excesos, (unsigned)excesos_totales,
+              (unsigned)(v.ocupacion_pormil / 10), (unsigned)(v.ocupacion_pormil % 10));
+}
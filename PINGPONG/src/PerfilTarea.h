@@ -0,0 +1,90 @@
+// src/PerfilTarea.h
+//
+// --- PERFIL DE UNA TAREA POR ITERACIÓN ---
+// inicio() / fin() alrededor del trabajo de cada iteración (Task_LogicaJuego,
+// Task_Dibujo). Mide con hal::contadorCiclos() (CCOUNT en ESP32), cuenta las
+// iteraciones que pasan del presupuesto y cada segundo cierra una ventana con
+// media, máximo, excesos y ocupación de la tarea. Solo escribe la tarea
+// medida; los lectores (serie, HUD) leen la última ventana sin cerrojos.
+// Con -D PINGPONG_PERFIL=0 inicio() y fin() quedan vacías.
+
+#ifndef PERFIL_TAREA_H
+#define PERFIL_TAREA_H
+
+#include "Hal.h"
+
+#ifndef PINGPONG_PERFIL
+#define PINGPONG_PERFIL 1
+#endif
+
+class PerfilTarea {
+public:
+    // Resumen de la última ventana cerrada
+    struct Ventana {
+        uint32_t iteraciones;
+        uint32_t media_us;
+        uint32_t max_us;
+        uint32_t excesos;          // Iteraciones por encima del presupuesto
+        uint32_t ocupacion_pormil; // Tiempo de trabajo / duración de la ventana
+        uint32_t duracion_ms;
+    };
+
+    static const uint32_t US_POR_VENTANA = 1000000;
+
+    explicit PerfilTarea(uint32_t presupuesto_us);
+
+    inline void inicio();
+    inline void fin();
+
+    const Ventana &ventana() const { return ultima; }
+    uint32_t excesosTotales() const { return excesos_totales; }
+    uint32_t presupuestoUs() const { return presupuesto_us; }
+    // Iteraciones por segundo de la última ventana
+    uint32_t frecuenciaHz() const {
+        return ultima.duracion_ms ? ultima.iteraciones * 1000 / ultima.duracion_ms : 0;
+    }
+
+    void imprimir(const char *nombre) const;
+
+private:
+    void cerrarVentana(uint32_t ahora_us);
+
+    uint32_t presupuesto_us;
+    uint32_t presupuesto_ciclos; // Se calcula en la primera iteración
+    uint32_t ciclos_inicio;
+    uint32_t inicio_ventana_us;
+    // Ventana en curso (ciclos)
+    uint32_t iteraciones;
+    uint64_t suma_ciclos;
+    uint32_t max_ciclos;
+    uint32_t excesos;
+    uint32_t excesos_totales;
+    Ventana ultima;
+};
+
+#if PINGPONG_PERFIL
+inline void PerfilTarea::inicio() {
+    ciclos_inicio = hal::contadorCiclos();
+}
+
+inline void PerfilTarea::fin() {
+    uint32_t ciclos = hal::contadorCiclos() - ciclos_inicio;
+    if (presupuesto_ciclos == 0) {
+        presupuesto_ciclos = (uint32_t)((uint64_t)presupuesto_us * hal::ciclosPorSegundo() / 1000000);
+    }
+    iteraciones++;
+    suma_ciclos += ciclos;
+    if (ciclos > max_ciclos) max_ciclos = ciclos;
+    if (ciclos > presupuesto_ciclos) {
+        excesos++;
+        excesos_totales++;
+    }
+    uint32_t ahora_us = hal::micros();
+    if (ahora_us - inicio_ventana_us >= US_POR_VENTANA) cerrarVentana(ahora_us);
+}
+#else
+inline void PerfilTarea::inicio() {}
+inline void PerfilTarea::fin() {}
+#endif
+
+#endif // PERFIL_TAREA_H
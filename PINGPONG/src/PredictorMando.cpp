@@ -0,0 +1,86 @@
+// src/PredictorMando.cpp
+
+#include "PredictorMando.h"
+#include "Protocolo.h"
+
+// El mínimo del tránsito sube 1 us por muestra para seguir la deriva entre
+// los dos relojes (decenas de ppm) sin quedar anclado a un valor viejo
+static const int32_t DERIVA_MIN_US = 1;
+
+PredictorMando::PredictorMando() {
+    reiniciar();
+}
+
+void PredictorMando::reiniciar() {
+    hay_muestra = false;
+    eje = 2048;
+    ultima_marca = 0;
+    tiempo_emisor_us = 0;
+    ultima_llegada_us = 0;
+    transito_min_us = 0;
+    retardo_us = PINGPONG_LATENCIA_BASE_US;
+    intervalo_us = 5000;
+    velocidad_cps = 0;
+}
+
+void PredictorMando::agregar(int nuevo_eje, uint16_t marca_emisor, uint32_t llegada_us, uint32_t espera_us) {
+    // Primera muestra, o el mando estuvo callado: no hay velocidad que estimar
+    if (!hay_muestra || llegada_us - ultima_llegada_us > protocolo::MS_MANDO_INACTIVO * 1000UL) {
+        reiniciar();
+        hay_muestra = true;
+        eje = nuevo_eje;
+        ultima_marca = marca_emisor;
+        tiempo_emisor_us = (uint32_t)marca_emisor * protocolo::US_POR_MARCA;
+        ultima_llegada_us = llegada_us;
+        transito_min_us = (int32_t)(llegada_us - tiempo_emisor_us);
+        return;
+    }
+
+    // 1. Reloj del mando sin vueltas: la marca de 16 bits da la vuelta cada 6,5 s
+    uint32_t dt_us = (uint32_t)(uint16_t)(marca_emisor - ultima_marca) * protocolo::US_POR_MARCA;
+    if (dt_us == 0 || dt_us > 0x8000UL * protocolo::US_POR_MARCA) return; // Repetida o vieja
+    tiempo_emisor_us += dt_us;
+
+    // 2. Velocidad: diferencia entre muestras, suavizada a la mitad para no amplificar el ruido
+    int32_t v = (int32_t)((int64_t)(nuevo_eje - eje) * 1000000 / (int64_t)dt_us);
+    velocidad_cps = (velocidad_cps + v) / 2;
+    // Separación típica solo mientras se mueve (quieto el mando manda cada 50 ms)
+    if (nuevo_eje != eje && dt_us < protocolo::MS_ENTRE_KEEPALIVE * 1000UL) {
+        intervalo_us = (intervalo_us * 7 + dt_us) / 8;
+    }
+
+    // 3. Retardo: exceso del tránsito sobre el mínimo reciente + la base fija.
+    // Las muestras rehechas de tramas perdidas esperaron en el mando a
+    // propósito: solo cuenta la más nueva de cada trama (espera 0).
+    int32_t transito = (int32_t)(llegada_us - tiempo_emisor_us);
+    transito_min_us += DERIVA_MIN_US;
+    if (transito < transito_min_us) transito_min_us = transito;
+    if (espera_us == 0) {
+        retardo_us = (uint32_t)(transito - transito_min_us) + PINGPONG_LATENCIA_BASE_US;
+    }
+
+    eje = nuevo_eje;
+    ultima_marca = marca_emisor;
+    ultima_llegada_us = llegada_us;
+}
+
+int PredictorMando::estimar(uint32_t ahora_us) const {
+#if PINGPONG_PREDICCION_REMOTA
+    if (!hay_muestra) return eje;
+
+    // Sin muestras nuevas durante varios intervalos: el mando se detuvo
+    uint32_t edad_us = ahora_us - ultima_llegada_us;
+    if (edad_us > 3 * intervalo_us + 2000) return eje;
+
+    uint32_t horizonte_us = edad_us + retardo_us;
+    if (horizonte_us > PINGPONG_HORIZONTE_MAX_MS * 1000UL) horizonte_us = PINGPONG_HORIZONTE_MAX_MS * 1000UL;
+
+    int32_t valor = eje + (int32_t)((int64_t)velocidad_cps * horizonte_us / 1000000);
+    if (valor < 0) valor = 0;
+    if (valor > 4095) valor = 4095;
+    return (int)valor;
+#else
+    (void)ahora_us;
+    return eje;
+#endif
+}
@@ -0,0 +1,62 @@
+// src/PredictorMando.h
+//
+// --- COMPENSACIÓN DE LATENCIA DEL MANDO REMOTO ---
+// Con las muestras marcadas por el reloj del mando estima la velocidad del eje
+// y extrapola el valor al instante del paso de física actual:
+//   eje(ahora) = eje + velocidad * (edad de la muestra + retardo de la radio)
+// El retardo de un solo sentido no se puede medir sin relojes sincronizados;
+// se estima como el exceso del tránsito (llegada - envío) sobre el mínimo
+// reciente, más PINGPONG_LATENCIA_BASE_US (aire + proceso en el mando).
+// El horizonte total se limita a PINGPONG_HORIZONTE_MAX_MS, y si el mando dejó
+// de mandar muestras (quieto: solo envía cuando cambia) no se extrapola.
+
+#ifndef PREDICTOR_MANDO_H
+#define PREDICTOR_MANDO_H
+
+#include <stdint.h>
+
+// 0 desactiva la extrapolación (se usa la última muestra tal cual)
+#ifndef PINGPONG_PREDICCION_REMOTA
+#define PINGPONG_PREDICCION_REMOTA 1
+#endif
+
+#ifndef PINGPONG_HORIZONTE_MAX_MS
+#define PINGPONG_HORIZONTE_MAX_MS 30
+#endif
+
+#ifndef PINGPONG_LATENCIA_BASE_US
+#define PINGPONG_LATENCIA_BASE_US 1500
+#endif
+
+class PredictorMando {
+public:
+    PredictorMando();
+
+    // Olvida el historial (mando desconectado o recién conectado)
+    void reiniciar();
+
+    // Agrega una muestra: eje 0-4095, marca del mando (100 us), hora de llegada
+    // (hal::micros()) y cuánto esperó en el mando antes de salir su trama
+    // (0 para la muestra más nueva; más para las copias de tramas perdidas)
+    void agregar(int eje, uint16_t marca_emisor, uint32_t llegada_us, uint32_t espera_us);
+
+    // Valor extrapolado a 'ahora_us' (0-4095)
+    int estimar(uint32_t ahora_us) const;
+
+    // Estadísticas
+    uint32_t retardoUs() const { return retardo_us; }   // Retardo estimado de la radio
+    int32_t velocidad() const { return velocidad_cps; }  // Cuentas por segundo
+
+private:
+    bool hay_muestra;
+    int eje;
+    uint16_t ultima_marca;
+    uint32_t tiempo_emisor_us;   // Reloj del mando sin vueltas (acumulado)
+    uint32_t ultima_llegada_us;
+    int32_t transito_min_us;     // Mínimo reciente de (llegada - envío)
+    uint32_t retardo_us;
+    uint32_t intervalo_us;       // Separación típica entre muestras en movimiento
+    int32_t velocidad_cps;
+};
+
+#endif // PREDICTOR_MANDO_H
@@ -0,0 +1,108 @@
+// src/Registro.cpp
+// Parte común: la cola, el formateo y la decodificación de las trazas
+
+#include "Registro.h"
+#include "ColaMPSC.h"
+#include "Hal.h"
+#include <atomic>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace registro {
+
+// 32 entradas (~3 KB): una ráfaga de arranque o unos 150 ms de trazas a 200 Hz
+static ColaMPSC<Entrada, 32> cola;
+static std::atomic<bool> trazas_activas(false);
+
+// Mismo orden y nombres en herramientas/trazas.py
+static const char *NOMBRES_TRAZA[NUM_TRAZAS] = {
+    "muestra_remota", // jugador eje transito_us
+    "boton",          // pin presionado marca_us
+    "frame"           // filas bytes numero
+};
+
+static const char LETRA_NIVEL[] = { '-', 'E', 'A', 'I', 'D' };
+
+void escribir(Nivel nivel, const char *fmt, ...) {
+    Entrada e;
+    e.marca_us = hal::micros();
+    e.nivel = nivel;
+    e.es_traza = false;
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(e.texto, sizeof(e.texto), fmt, args);
+    va_end(args);
+    cola.meter(e);
+    alEncolar();
+}
+
+void trazar(Traza traza, uint32_t a, uint32_t b, uint32_t c) {
+    Entrada e;
+    e.marca_us = hal::micros();
+    e.nivel = NIVEL_DEPURACION;
+    e.es_traza = true;
+    e.traza = traza;
+    e.args[0] = a;
+    e.args[1] = b;
+    e.args[2] = c;
+    cola.meter(e);
+    alEncolar();
+}
+
+void activarTrazas(bool activas) { trazas_activas.store(activas, std::memory_order_relaxed); }
+bool trazasActivas() { return trazas_activas.load(std::memory_order_relaxed); }
+
+uint32_t descartados() { return cola.descartadosTotales(); }
+bool hayPendientes() { return !cola.vacia(); }
+
+// "[segundos.ms] N texto" o "[segundos.ms] T nombre a b c"
+static void formatear(Entrada &e, char *linea, size_t len) {
+    unsigned seg = (unsigned)(e.marca_us / 1000000UL);
+    unsigned ms = (unsigned)((e.marca_us / 1000UL) % 1000UL);
+    if (e.es_traza) {
+        const char *nombre = e.traza < NUM_TRAZAS ? NOMBRES_TRAZA[e.traza] : "?";
+        snprintf(linea, len, "[%u.%03u] T %s %u %u %u", seg, ms, nombre,
+                 (unsigned)e.args[0], (unsigned)e.args[1], (unsigned)e.args[2]);
+    } else {
+        // Los mensajes heredados de logf() traen su propio salto de línea
+        size_t n = strlen(e.texto);
+        if (n > 0 && e.texto[n - 1] == '\n') e.texto[n - 1] = '\0';
+        char letra = e.nivel <= NIVEL_DEPURACION ? LETRA_NIVEL[e.nivel] : '?';
+        snprintf(linea, len, "[%u.%03u] %c %s", seg, ms, letra, e.texto);
+    }
+}
+
+static size_t escribirLE(uint8_t *p, uint32_t v, int bytes) {
+    for (int i = 0; i < bytes; i++) p[i] = (uint8_t)(v >> (8 * i));
+    return bytes;
+}
+
+bool siguienteLinea(char *linea, size_t len) {
+    Entrada e;
+    if (!cola.sacar(e)) return false;
+    formatear(e, linea, len);
+    return true;
+}
+
+size_t siguienteSalida(uint8_t *buf, size_t len) {
+    Entrada e;
+    if (len < BYTES_TRAZA || !cola.sacar(e)) return 0;
+    if (e.es_traza) {
+        size_t n = 0;
+        buf[n++] = SINCRONIA_TRAZA;
+        buf[n++] = e.traza;
+        n += escribirLE(buf + n, e.marca_us, 4);
+        n += escribirLE(buf + n, e.args[0], 2);
+        n += escribirLE(buf + n, e.args[1], 2);
+        n += escribirLE(buf + n, e.args[2], 4);
+        return n;
+    }
+    char *linea = (char *)buf;
+    formatear(e, linea, len - 1);
+    size_t n = strlen(linea);
+    linea[n++] = '\n';
+    return n;
+}
+
+} // namespace registro
@@ -0,0 +1,142 @@
+// src/Registro.h
+//
+// --- REGISTRO ASÍNCRONO (mensajes y trazas) ---
+// Una línea por Serial a 115200 baudios tarda ~1 ms en salir, y con println
+// la tarea que escribe espera ese milisegundo. Aquí escribir solo formatea la
+// línea y la deja en una ColaMPSC; una tarea de prioridad 0 en el Core 0 la
+// saca y la envía por la UART (Registro_esp32.cpp). En PC se imprime en el
+// acto por hal::log() (Registro_native.cpp).
+// - Niveles en compilación: con -D PINGPONG_NIVEL_LOG=2 los REGISTRO_INFO y
+//   REGISTRO_DEPURACION quedan en un if (0) que el compilador elimina (los
+//   argumentos se siguen revisando, pero no se evalúan).
+// - Trazas: eventos frecuentes (muestras del mando, botones, frames) que se
+//   guardan en binario, sin formatear. Por la UART salen como registros de
+//   BYTES_TRAZA bytes (como texto serían ~45 caracteres cada una y no caben en
+//   los 11,5 KB/s de la línea); herramientas/trazas.py los decodifica en el
+//   PC. En PC se imprimen como texto. Se activan en marcha (comando serie
+//   'v'); apagadas cuestan una lectura atómica.
+// Si la cola se llena, el mensaje se descarta (nunca se espera) y la tarea
+// de vaciado informa cuántos se perdieron.
+// Los informes pedidos por serie (latencia, perfil, enlace) siguen usando
+// hal::log()/hal::logf() directamente: salen del loop y pueden ser largos.
+// Separación texto/binario en la UART: todo lo que sale por Serial lo hace
+// de a una línea completa (terminada en '\n') o un registro de traza entero
+// por cada Serial.write, y la UART no mezcla dos escrituras. Así cada unidad
+// empieza en el límite de la anterior y el lector reconoce la traza por su
+// primer byte. Nada debe armar una línea con varias escrituras a Serial
+// (print + println, printf por partes): hal::log() y hal::logf() ya cumplen.
+
+#ifndef REGISTRO_H
+#define REGISTRO_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifndef PINGPONG_NIVEL_LOG
+#define PINGPONG_NIVEL_LOG 3 // INFO
+#endif
+
+// 0 quita las trazas al compilar
+#ifndef PINGPONG_TRAZAS
+#define PINGPONG_TRAZAS 1
+#endif
+
+namespace registro {
+
+enum Nivel : uint8_t {
+    NIVEL_NADA = 0,
+    NIVEL_ERROR = 1,
+    NIVEL_AVISO = 2,
+    NIVEL_INFO = 3,
+    NIVEL_DEPURACION = 4
+};
+
+// Tres argumentos por traza; su significado está en NOMBRES_TRAZA (Registro.cpp).
+// a y b salen por la UART con 16 bits, c con 32.
+enum Traza : uint8_t {
+    TRAZA_MUESTRA_REMOTA, // jugador, eje, tránsito estimado (us)
+    TRAZA_BOTON,          // pin, presionado, hora del flanco (us)
+    TRAZA_FRAME,          // filas enviadas, bytes enviados, número de frame
+    NUM_TRAZAS
+};
+
+static const size_t LARGO_TEXTO = 88;
+
+// Registro binario de una traza en la UART (little-endian, sin relleno):
+//   SINCRONIA_TRAZA | traza | marca_us (4) | a (2) | b (2) | c (4)
+// Las líneas de texto empiezan con '[' y terminan en '\n', así que el lector
+// distingue uno de otro por el primer byte.
+static const uint8_t SINCRONIA_TRAZA = 0xA5;
+static const size_t BYTES_TRAZA = 14;
+
+// Una entrada de la cola: texto ya formateado o traza binaria
+struct Entrada {
+    uint32_t marca_us;
+    uint8_t nivel;  // NIVEL_* de un texto
+    bool es_traza;
+    uint8_t traza;  // Traza
+    union {
+        char texto[LARGO_TEXTO];
+        uint32_t args[3];
+    };
+};
+
+// Arranca el vaciado (ESP32: crea la tarea). Lo escrito antes queda en la cola.
+void iniciar();
+
+// Desde cualquier tarea (no desde una ISR). Se corta en LARGO_TEXTO - 1 caracteres.
+void escribir(Nivel nivel, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+void trazar(Traza traza, uint32_t a, uint32_t b, uint32_t c);
+void activarTrazas(bool activas);
+bool trazasActivas();
+
+// Espera hasta que todo lo encolado haya salido (antes del Deep Sleep).
+// false si no terminó en timeout_ms.
+bool esperarVacio(uint32_t timeout_ms);
+
+uint32_t descartados();
+
+// --- Para el vaciado (Registro_esp32.cpp / Registro_native.cpp) ---
+// Saca la próxima entrada y la deja como línea de texto (sin salto final)
+bool siguienteLinea(char *linea, size_t len);
+// Igual, pero lista para la UART: texto con '\n' o registro de BYTES_TRAZA
+// bytes. Devuelve los bytes escritos (0: cola vacía).
+size_t siguienteSalida(uint8_t *buf, size_t len);
+bool hayPendientes();
+void alEncolar(); // Lo llama escribir()/trazar() después de cada entrada
+
+} // namespace registro
+
+#if PINGPONG_NIVEL_LOG >= 1
+#define REGISTRO_ERROR(...) registro::escribir(registro::NIVEL_ERROR, __VA_ARGS__)
+#else
+#define REGISTRO_ERROR(...) do { if (0) registro::escribir(registro::NIVEL_ERROR, __VA_ARGS__); } while (0)
+#endif
+
+#if PINGPONG_NIVEL_LOG >= 2
+#define REGISTRO_AVISO(...) registro::escribir(registro::NIVEL_AVISO, __VA_ARGS__)
+#else
+#define REGISTRO_AVISO(...) do { if (0) registro::escribir(registro::NIVEL_AVISO, __VA_ARGS__); } while (0)
+#endif
+
+#if PINGPONG_NIVEL_LOG >= 3
+#define REGISTRO_INFO(...) registro::escribir(registro::NIVEL_INFO, __VA_ARGS__)
+#else
+#define REGISTRO_INFO(...) do { if (0) registro::escribir(registro::NIVEL_INFO, __VA_ARGS__); } while (0)
+#endif
+
+#if PINGPONG_NIVEL_LOG >= 4
+#define REGISTRO_DEPURACION(...) registro::escribir(registro::NIVEL_DEPURACION, __VA_ARGS__)
+#else
+#define REGISTRO_DEPURACION(...) do { if (0) registro::escribir(registro::NIVEL_DEPURACION, __VA_ARGS__); } while (0)
+#endif
+
+#if PINGPONG_TRAZAS
+#define REGISTRO_TRAZA(traza, a, b, c) \
+    do { if (registro::trazasActivas()) registro::trazar((traza), (a), (b), (c)); } while (0)
+#else
+#define REGISTRO_TRAZA(traza, a, b, c) do { if (0) registro::trazar((traza), (a), (b), (c)); } while (0)
+#endif
+
+#endif // REGISTRO_H
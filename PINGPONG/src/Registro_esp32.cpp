@@ -0,0 +1,64 @@
+// src/Registro_esp32.cpp
+
+#include "Registro.h"
+#include <Arduino.h>
+#include <atomic>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+namespace registro {
+
+// La cola se revisa cada 10 ms: a 115200 baudios salen ~115 caracteres en
+// ese tiempo, así que una tanda normal se vacía en una o dos vueltas. Las
+// trazas salen en binario (BYTES_TRAZA por traza).
+static const uint32_t PERIODO_VACIADO_MS = 10;
+
+static TaskHandle_t tarea = NULL;
+static std::atomic<bool> enviando(false); // La tarea tiene una línea sacada que aún no salió
+
+static void tareaVaciado(void *parametro) {
+    uint8_t salida[128];
+    uint32_t descartes_informados = 0;
+    for (;;) {
+        enviando.store(true);
+        size_t n;
+        while ((n = siguienteSalida(salida, sizeof(salida))) > 0) {
+            Serial.write(salida, n);
+        }
+        enviando.store(false);
+
+        uint32_t d = descartados();
+        if (d != descartes_informados) {
+            Serial.printf("[registro] %u mensajes descartados (cola llena)\n", (unsigned)(d - descartes_informados));
+            descartes_informados = d;
+        }
+        vTaskDelay(pdMS_TO_TICKS(PERIODO_VACIADO_MS));
+    }
+}
+
+void iniciar() {
+    if (tarea != NULL) return;
+    // Prioridad 0 en el Core 0: solo corre cuando el dibujo y el WiFi no necesitan la CPU
+    xTaskCreatePinnedToCore(tareaVaciado, "Registro", 3072, NULL, 0, &tarea, 0);
+}
+
+// La tarea lo encuentra en su próxima revisión: avisarle costaría más que esperar
+void alEncolar() { }
+
+bool esperarVacio(uint32_t timeout_ms) {
+    uint32_t inicio = millis();
+    if (tarea == NULL) {
+        // Sin tarea todavía: vacía quien pregunta
+        uint8_t salida[128];
+        size_t n;
+        while ((n = siguienteSalida(salida, sizeof(salida))) > 0) Serial.write(salida, n);
+    }
+    while (hayPendientes() || enviando.load()) {
+        if (millis() - inicio >= timeout_ms) return false;
+        vTaskDelay(pdMS_TO_TICKS(1));
+    }
+    Serial.flush(); // Hasta que el último byte salga de la UART
+    return true;
+}
+
+} // namespace registro
@@ -0,0 +1,23 @@
+// src/Registro_native.cpp
+// En PC no hay tareas: cada entrada se imprime en cuanto se encola (hal::log,
+// que respeta sim::silenciarLog)
+
+#include "Registro.h"
+#include "Hal.h"
+
+namespace registro {
+
+void iniciar() { }
+
+void alEncolar() {
+    char linea[128];
+    while (siguienteLinea(linea, sizeof(linea))) hal::log(linea);
+}
+
+bool esperarVacio(uint32_t timeout_ms) {
+    (void)timeout_ms;
+    alEncolar();
+    return true;
+}
+
+} // namespace registro
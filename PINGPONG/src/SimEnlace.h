@@ -0,0 +1,28 @@
+// src/SimEnlace.h
+//
+// --- LATENCIA MANDO -> PALETA CON UN ENLACE ESP-NOW SIMULADO (solo PC) ---
+// Corre el emisor del mando (EmisorMando, el mismo código que PALETA) y el
+// camino de recepción de la consola (OnDataRecv -> Juego::recibirPaquete)
+// contra EnlaceSimulado, con pérdidas, latencia, jitter y desorden repetibles.
+// El mando alterna saltos del eje entre dos posiciones y se mide cuánto tarda
+// la Paleta 1 en cruzar el punto medio (percentiles en ms); al final imprime
+// también los histogramas por etapa de LatenciaMando.
+//   pio run -e native_enlace
+//   .pio/build/native_enlace/program [segundos] [--perdida 0.1] [--rafaga 0.3]
+//       [--latencia us] [--jitter us] [--dist uniforme|normal|exponencial]
+//       [--reorden 0.02] [--semilla n]
+// --rafaga es la probabilidad de perder la trama que sigue a una perdida; sin
+// ella vale lo mismo que --perdida (pérdidas independientes).
+
+#ifndef SIM_ENLACE_H
+#define SIM_ENLACE_H
+
+#include "Juego.h"
+
+class SimEnlace {
+public:
+    // Devuelve el código de salida del programa
+    static int ejecutar(Juego &juego, int argc, char **argv);
+};
+
+#endif // SIM_ENLACE_H
@@ -0,0 +1,161 @@
+// src/SimEnlace_native.cpp
+
+#include "SimEnlace.h"
+#include "EmisorMando.h"
+#include "EspNowSimulado.h"
+#include "PasoFijo.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static Juego *juego_sim = NULL;
+
+// Igual que OnDataRecv en main.cpp
+static void OnDataRecv(const uint8_t *mac_addr, const uint8_t *incomingData, int len) {
+    (void)mac_addr;
+    juego_sim->recibirPaquete(incomingData, len);
+}
+
+static const uint32_t RESOLUCION_US = 100;        // Paso del reloj simulado
+static const uint32_t PERIODO_MANDO_US = 5000;    // PALETA_MPU_HZ = 200
+static const uint32_t PERIODO_SALTO_US = 400000;  // Un salto del eje cada 400 ms
+static const uint32_t PERIODO_DIBUJO_US = 1000000UL / PINGPONG_FPS_MAX; // Ritmo de Task_Dibujo
+static const int EJE_BAJO = 1000;
+static const int EJE_ALTO = 3000;
+static const int MAX_SALTOS = 4096;
+
+static int compararU32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static EnlaceSimulado::Distribucion distribucionDe(const char *s) {
+    if (strcmp(s, "normal") == 0) return EnlaceSimulado::DISTRIBUCION_NORMAL;
+    if (strcmp(s, "exponencial") == 0) return EnlaceSimulado::DISTRIBUCION_EXPONENCIAL;
+    return EnlaceSimulado::DISTRIBUCION_UNIFORME;
+}
+
+int SimEnlace::ejecutar(Juego &juego, int argc, char **argv) {
+    int segundos = 60;
+    EnlaceSimulado::Config config;
+    for (int i = 1; i < argc; i++) {
+        bool hay_valor = i + 1 < argc;
+        if (strcmp(argv[i], "--perdida") == 0 && hay_valor) config.perdida = (float)atof(argv[++i]);
+        else if (strcmp(argv[i], "--rafaga") == 0 && hay_valor) config.rafaga = (float)atof(argv[++i]);
+        else if (strcmp(argv[i], "--latencia") == 0 && hay_valor) config.latencia_us = (uint32_t)atoi(argv[++i]);
+        else if (strcmp(argv[i], "--jitter") == 0 && hay_valor) config.jitter_us = (uint32_t)atoi(argv[++i]);
+        else if (strcmp(argv[i], "--dist") == 0 && hay_valor) config.distribucion = distribucionDe(argv[++i]);
+        else if (strcmp(argv[i], "--reorden") == 0 && hay_valor) config.reorden = (float)atof(argv[++i]);
+        else if (strcmp(argv[i], "--semilla") == 0 && hay_valor) config.semilla = (uint32_t)strtoul(argv[++i], NULL, 10);
+        else segundos = atoi(argv[i]);
+    }
+
+    hal::sim::silenciarLog(true);
+    hal::semillaAleatoria(config.semilla);
+    espnow_sim::enlace().configurar(config);
+    juego_sim = &juego;
+    esp_now_register_recv_cb(OnDataRecv);
+
+    // Partida VS MAQUINA directa; el mando remoto mueve la Paleta 1
+    juego.gameState = STATE_VS_AI;
+    juego.last_active_state = STATE_VS_AI;
+    juego.pelota.reiniciar();
+
+    EmisorMando emisor(1);
+    protocolo::TramaMando_t trama;
+    const uint8_t mac_consola[6] = {0};
+    PasoFijo paso(PINGPONG_TICK_HZ);
+    paso.reiniciar(hal::micros());
+
+    // Punto medio entre las dos posiciones de la paleta
+    const int RECORRIDO = 64 - Paleta::ALTO;
+    const int y_medio = (EJE_BAJO + EJE_ALTO) / 2 * RECORRIDO / 4095;
+
+    static uint32_t latencias[MAX_SALTOS];
+    int saltos = 0;
+    int sin_llegar = 0;
+    bool arriba = false;        // Eje actual en EJE_ALTO
+    bool esperando = false;     // Salto emitido, paleta aún sin cruzar
+    uint32_t inicio_salto_us = 0;
+    uint32_t proximo_mando_us = hal::micros();
+    uint32_t proximo_salto_us = hal::micros() + PERIODO_SALTO_US;
+    uint32_t ultimo_dibujo_us = hal::micros() - PERIODO_DIBUJO_US;
+    bool dibujo_notificado = true;
+    const uint32_t fin_us = hal::micros() + (uint32_t)segundos * 1000000UL;
+
+    while ((int32_t)(hal::micros() - fin_us) < 0) {
+        hal::sim::avanzarReloj(RESOLUCION_US);
+        uint32_t ahora = hal::micros();
+
+        // 1. Mando: salto del eje y una muestra cada PERIODO_MANDO_US
+        if ((int32_t)(ahora - proximo_salto_us) >= 0) {
+            if (esperando) sin_llegar++;
+            arriba = !arriba;
+            esperando = true;
+            inicio_salto_us = proximo_mando_us; // Cuenta desde la muestra que lo lleva
+            proximo_salto_us += PERIODO_SALTO_US;
+        }
+        if ((int32_t)(ahora - proximo_mando_us) >= 0) {
+            int eje = arriba ? EJE_ALTO : EJE_BAJO;
+            if (emisor.debeEnviar(ahora / 1000, eje, false)) {
+                int bytes = emisor.armarTrama(ahora, eje, false, trama);
+                esp_now_send(mac_consola, (const uint8_t *)&trama, bytes);
+            }
+            proximo_mando_us += PERIODO_MANDO_US;
+        }
+
+        // 2. Radio
+        espnow_sim::procesar(ahora);
+
+        // 3. Consola: pasos de física pendientes
+        int pasos = paso.pasosPendientes(ahora);
+        for (int i = 0; i < pasos; i++) {
+            juego.score_p1 = 0; // La partida no debe terminar durante la medición
+            juego.score_p2 = 0;
+            dibujo_notificado = juego.actualizarLogica() || dibujo_notificado;
+            if (esperando && (arriba ? juego.paleta1.y >= y_medio : juego.paleta1.y <= y_medio)) {
+                if (saltos < MAX_SALTOS) latencias[saltos++] = ahora - inicio_salto_us;
+                esperando = false;
+            }
+        }
+
+        // 4. Dibujo como Task_Dibujo: si la lógica avisó y pasó el periodo
+        // (cierra las trazas de LatenciaMando)
+        if (dibujo_notificado && ahora - ultimo_dibujo_us >= PERIODO_DIBUJO_US) {
+            juego.dibujarPantalla();
+            ultimo_dibujo_us = ahora;
+            dibujo_notificado = false;
+        }
+    }
+
+    // --- Informe ---
+    const EnlaceSimulado &e = espnow_sim::enlace();
+    const EstadisticasEnlace &r = juego.enlace_j1;
+    printf("Enlace: perdida %.3f (rafaga %.2f) | latencia %u us + jitter %u us | reorden %.3f | semilla %u\n",
+           config.perdida, e.rafagaEfectiva(), (unsigned)config.latencia_us, (unsigned)config.jitter_us,
+           config.reorden, (unsigned)config.semilla);
+    printf("Radio:   enviadas %u | perdidas %u | reordenadas %u | entregadas %u\n",
+           (unsigned)e.enviadas, (unsigned)e.perdidas, (unsigned)e.reordenadas, (unsigned)e.entregadas);
+    printf("Consola: recibidas %u | perdidas %u | recuperadas %u | fuera de orden %u | jitter %u us | cola llena %u\n",
+           (unsigned)r.recibidas, (unsigned)r.perdidas, (unsigned)r.recuperadas, (unsigned)r.fuera_de_orden,
+           (unsigned)r.jitterUs(), (unsigned)juego.descartesColaRemota(1));
+
+    if (saltos == 0) {
+        printf("Ningun salto llego a la paleta\n");
+        return 1;
+    }
+    qsort(latencias, saltos, sizeof(uint32_t), compararU32);
+    uint64_t suma = 0;
+    for (int i = 0; i < saltos; i++) suma += latencias[i];
+    printf("Latencia mando->paleta (%d saltos, %d sin llegar): p50 %.1f ms | p90 %.1f | p99 %.1f | max %.1f | media %.1f\n",
+           saltos, sin_llegar,
+           latencias[saltos * 50 / 100] / 1000.0, latencias[saltos * 90 / 100] / 1000.0,
+           latencias[saltos * 99 / 100] / 1000.0, latencias[saltos - 1] / 1000.0,
+           (double)suma / saltos / 1000.0);
+
+    // Mismo informe que el comando 'l' del monitor serie en la consola
+    hal::sim::silenciarLog(false);
+    juego.latencia.imprimir(false);
+    return 0;
+}
@@ -0,0 +1,64 @@
+// src/TransporteST7920.h
+//
+// --- TRANSPORTE SPI POR HARDWARE + DMA PARA EL ST7920 (solo ESP32) ---
+// Usa el periférico VSPI (SCLK=18, MOSI=23, CS=5, los mismos pines que el
+// bit-banging anterior) con el driver spi_master de ESP-IDF:
+//   - Comandos de U8g2 (inicio, ahorro de energía): transacciones bloqueantes,
+//     a través de u8x8Byte() como callback de bytes de U8g2.
+//   - Frames: enviarFrame() codifica los tramos sucios (DiffST7920) al formato
+//     serie del ST7920 en un buffer DMA y encola la transacción sin esperar.
+//     Mientras se transmite el frame N, la tarea de dibujo ya arma el N+1.
+// Con -D PINGPONG_SPI_SOFTWARE se vuelve al bit-banging de U8g2.
+
+#ifndef TRANSPORTE_ST7920_H
+#define TRANSPORTE_ST7920_H
+
+#include <U8g2lib.h>
+#include "DiffST7920.h"
+#include "driver/spi_master.h"
+
+// Reloj del bus. 1 MHz es el valor que usa U8g2 para el ST7920 por SPI de
+// hardware; bajarlo si algún módulo muestra basura.
+#ifndef ST7920_SPI_HZ
+#define ST7920_SPI_HZ 1000000
+#endif
+
+class TransporteST7920 {
+public:
+    static const int PIN_SCLK = 18;
+    static const int PIN_MOSI = 23;
+    static const int PIN_CS = 5;
+
+    // Callback de bytes para u8g2_Setup_st7920_s_128x64_f()
+    static uint8_t u8x8Byte(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+
+    // Codifica y encola los cambios de 'frame'. Solo bloquea si el frame
+    // anterior todavía se está transmitiendo.
+    static void enviarFrame(DiffST7920 &diff, const uint8_t *frame);
+
+    // Espera a que termine la transacción DMA en curso (si la hay)
+    static void esperarFin();
+
+    // true si el último frame encolado ya salió del todo; fin_us = micros() al
+    // terminar (lo anota la interrupción de fin de transacción)
+    static bool frameTerminado(uint32_t &fin_us);
+
+    // Estadísticas
+    static uint32_t frames_encolados;
+    static uint32_t us_esperando_bus; // Tiempo que la CPU pasó bloqueada esperando al DMA
+
+private:
+    static void iniciarBus();
+    static void transmitirComandos();
+};
+
+// Objeto U8g2 con buffer completo cuyo bus es el VSPI de TransporteST7920
+class U8G2_ST7920_128X64_F_DMA : public U8G2 {
+public:
+    U8G2_ST7920_128X64_F_DMA(const u8g2_cb_t *rotacion, uint8_t reset) : U8G2() {
+        u8g2_Setup_st7920_s_128x64_f(&u8g2, rotacion, TransporteST7920::u8x8Byte, u8x8_gpio_and_delay_arduino);
+        u8x8_SetPin(getU8x8(), U8X8_PIN_RESET, reset);
+    }
+};
+
+#endif // TRANSPORTE_ST7920_H
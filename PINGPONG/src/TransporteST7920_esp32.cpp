@@ -0,0 +1,176 @@
+// src/TransporteST7920_esp32.cpp
+
+#include "TransporteST7920.h"
+#include <Arduino.h>
+#include <string.h>
+#include "esp_attr.h"
+#include "esp_timer.h"
+
+// --- FORMATO SERIE DEL ST7920 ---
+// Cada escritura empieza con un byte de sincronía (11111 RW RS 0) y cada byte
+// útil se envía partido en dos: nibble alto y nibble bajo, ambos en los 4 bits
+// altos. Igual que u8x8_cad_st7920_spi de U8g2.
+static const uint8_t SINCRONIA_CMD = 0xF8;
+static const uint8_t SINCRONIA_DATOS = 0xFA;
+
+// Peor caso de un frame: modo extendido + 64 filas completas
+// (comando Y + comando X + sincronía de datos + 16 bytes partidos en 32)
+static const size_t MAX_BYTES_FRAME = 3 + 64 * (3 + 3 + 1 + 32);
+
+// Doble buffer en DRAM apta para DMA: se codifica en uno mientras el otro se transmite
+DMA_ATTR static uint8_t buffers_dma[2][MAX_BYTES_FRAME + 1];
+static int buffer_libre = 0;
+
+// Comandos de U8g2 (se juntan entre START y END para no cortar el CS)
+DMA_ATTR static uint8_t buffer_comandos[64];
+static size_t bytes_comandos = 0;
+
+static spi_device_handle_t dispositivo = NULL;
+static spi_transaction_t transaccion_frame;
+static bool frame_en_curso = false;
+// Los escribe alTerminarTransaccion() (ISR del SPI)
+static volatile bool frame_terminado = true;
+static volatile uint32_t fin_frame_us = 0;
+
+uint32_t TransporteST7920::frames_encolados = 0;
+uint32_t TransporteST7920::us_esperando_bus = 0;
+
+// Corre en la interrupción de fin de cada transacción; solo marca los frames
+static void IRAM_ATTR alTerminarTransaccion(spi_transaction_t *t) {
+    if (t->user == &transaccion_frame) {
+        fin_frame_us = (uint32_t)esp_timer_get_time();
+        frame_terminado = true;
+    }
+}
+
+void TransporteST7920::iniciarBus() {
+    if (dispositivo != NULL) return;
+
+    spi_bus_config_t bus;
+    memset(&bus, 0, sizeof(bus));
+    bus.mosi_io_num = PIN_MOSI;
+    bus.miso_io_num = -1;
+    bus.sclk_io_num = PIN_SCLK;
+    bus.quadwp_io_num = -1;
+    bus.quadhd_io_num = -1;
+    bus.max_transfer_sz = MAX_BYTES_FRAME;
+    ESP_ERROR_CHECK(spi_bus_initialize(VSPI_HOST, &bus, SPI_DMA_CH_AUTO));
+
+    spi_device_interface_config_t dev;
+    memset(&dev, 0, sizeof(dev));
+    dev.clock_speed_hz = ST7920_SPI_HZ;
+    dev.mode = 3;
+    dev.spics_io_num = PIN_CS;
+    dev.flags = SPI_DEVICE_POSITIVE_CS | SPI_DEVICE_HALFDUPLEX; // El CS del ST7920 es activo en alto
+    dev.queue_size = 1;
+    dev.post_cb = alTerminarTransaccion;
+    ESP_ERROR_CHECK(spi_bus_add_device(VSPI_HOST, &dev, &dispositivo));
+}
+
+void TransporteST7920::esperarFin() {
+    if (!frame_en_curso) return;
+
+    uint32_t t0 = micros();
+    spi_transaction_t *terminada;
+    spi_device_get_trans_result(dispositivo, &terminada, portMAX_DELAY);
+    us_esperando_bus += micros() - t0;
+    frame_en_curso = false;
+}
+
+bool TransporteST7920::frameTerminado(uint32_t &fin_us) {
+    if (!frame_terminado) return false;
+    fin_us = fin_frame_us;
+    return true;
+}
+
+void TransporteST7920::transmitirComandos() {
+    if (bytes_comandos == 0) return;
+
+    spi_transaction_t t;
+    memset(&t, 0, sizeof(t));
+    t.length = bytes_comandos * 8;
+    t.tx_buffer = buffer_comandos;
+    spi_device_transmit(dispositivo, &t); // Bloqueante: son pocos bytes
+    bytes_comandos = 0;
+}
+
+uint8_t TransporteST7920::u8x8Byte(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr) {
+    (void)u8x8;
+    switch (msg) {
+        case U8X8_MSG_BYTE_INIT:
+            iniciarBus();
+            break;
+        case U8X8_MSG_BYTE_SET_DC:
+            break; // El ST7920 en serie indica comando/dato en el byte de sincronía
+        case U8X8_MSG_BYTE_START_TRANSFER:
+            esperarFin(); // No mezclar comandos con un frame a medio enviar
+            bytes_comandos = 0;
+            break;
+        case U8X8_MSG_BYTE_SEND: {
+            const uint8_t *datos = (const uint8_t *)arg_ptr;
+            for (int i = 0; i < arg_int; i++) {
+                if (bytes_comandos == sizeof(buffer_comandos)) transmitirComandos();
+                buffer_comandos[bytes_comandos++] = datos[i];
+            }
+            break;
+        }
+        case U8X8_MSG_BYTE_END_TRANSFER:
+            transmitirComandos();
+            break;
+        default:
+            return 0;
+    }
+    return 1;
+}
+
+// --- CODIFICACIÓN DE UN FRAME ---
+static inline size_t codificarComando(uint8_t *buf, size_t n, uint8_t cmd) {
+    buf[n++] = SINCRONIA_CMD;
+    buf[n++] = cmd & 0xF0;
+    buf[n++] = (uint8_t)(cmd << 4);
+    return n;
+}
+
+void TransporteST7920::enviarFrame(DiffST7920 &diff, const uint8_t *frame) {
+    uint8_t *buf = buffers_dma[buffer_libre];
+    size_t n = codificarComando(buf, 0, 0x3E); // Modo extendido + gráficos
+    const size_t cabecera = n;
+
+    // 1. Codificar los tramos sucios (el frame anterior puede seguir en el bus)
+    diff.enviarCambios(frame, [&](const DiffST7920::Tramo &t) {
+        // La GDRAM de 128x64 es de 256x32: la mitad inferior va a la derecha
+        uint8_t fila = t.fila;
+        uint8_t palabra = t.palabra;
+        if (fila >= 32) {
+            fila -= 32;
+            palabra += 8;
+        }
+        n = codificarComando(buf, n, 0x80 | fila);
+        n = codificarComando(buf, n, 0x80 | palabra);
+        buf[n++] = SINCRONIA_DATOS;
+        for (int i = 0; i < t.bytes; i++) {
+            buf[n++] = t.datos[i] & 0xF0;
+            buf[n++] = (uint8_t)(t.datos[i] << 4);
+        }
+    });
+
+    if (n == cabecera) return; // Nada cambió: el bus queda libre
+
+    // 2. Solo ahora hace falta que el frame anterior haya terminado
+    esperarFin();
+
+    // 3. Encolar por DMA y regresar de inmediato
+    memset(&transaccion_frame, 0, sizeof(transaccion_frame));
+    transaccion_frame.length = n * 8;
+    transaccion_frame.tx_buffer = buf;
+    transaccion_frame.user = &transaccion_frame; // Para alTerminarTransaccion()
+    frame_terminado = false;
+    if (spi_device_queue_trans(dispositivo, &transaccion_frame, portMAX_DELAY) == ESP_OK) {
+        frame_en_curso = true;
+        frames_encolados++;
+        buffer_libre ^= 1;
+    } else {
+        frame_terminado = true; // No salió: que nadie espere su fin
+        diff.invalidar();       // La copia ya cree enviados estos tramos: el próximo frame va completo
+    }
+}
@@ -0,0 +1,48 @@
+// src/TripleBuffer.h
+//
+// --- TRIPLE BUFFER SIN CERROJOS (un escritor, un lector) ---
+// Tres copias de T: el escritor llena la suya y la publica intercambiándola
+// con la del medio; el lector, cuando hay una nueva, intercambia la suya con
+// la del medio. Ninguno espera al otro y el lector siempre ve un T completo
+// (nunca uno a medio escribir). Si el escritor publica varias veces entre dos
+// lecturas, el lector solo ve la última.
+
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <stdint.h>
+#include <atomic>
+
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() : escritura(0), medio(1), lectura(2) {}
+
+    // --- Lado del escritor ---
+    // Copia que se puede modificar libremente hasta llamar a publicar()
+    T &paraEscribir() { return copias[escritura]; }
+
+    void publicar() {
+        escritura = medio.exchange(escritura | BIT_NUEVA, std::memory_order_acq_rel) & MASCARA;
+    }
+
+    // --- Lado del lector ---
+    // Devuelve la última copia publicada; sigue siendo válida hasta la próxima llamada
+    const T &leer() {
+        if (medio.load(std::memory_order_relaxed) & BIT_NUEVA) {
+            lectura = medio.exchange(lectura, std::memory_order_acq_rel) & MASCARA;
+        }
+        return copias[lectura];
+    }
+
+private:
+    static const uint32_t BIT_NUEVA = 0x4; // La copia del medio aún no fue leída
+    static const uint32_t MASCARA = 0x3;
+
+    T copias[3];
+    uint32_t escritura;          // Solo la toca el escritor
+    std::atomic<uint32_t> medio; // Índice compartido | BIT_NUEVA
+    uint32_t lectura;            // Solo la toca el lector
+};
+
+#endif // TRIPLE_BUFFER_H
@@ -1,26 +1,32 @@
 #include <Arduino.h>
-#include <U8g2lib.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "Juego.h" 
+#include "Benchmark.h"
+#include "PasoFijo.h"
+#include "MedidorJitter.h"
+#include "AdcContinuo.h"
+#include "Registro.h"
 #include "esp_sleep.h" 
 #include <WiFi.h> 
 #include <esp_now.h> 
 
-// Definición de variables globales y externas (necesarias para el ESP-NOW callback)
-extern portMUX_TYPE scoreMux;
-
 // --- HANDLES DE TAREAS (Para suspensión segura en Deep Sleep) ---
 TaskHandle_t xTaskLogicaJuegoHandle = NULL;
 TaskHandle_t xTaskDibujoHandle = NULL;
+TaskHandle_t xTaskAudioHandle = NULL;
 
-
-// Definición global del objeto U8g2 (Core 0)
-U8G2_ST7920_128X64_1_SW_SPI u8g2(U8G2_R0, /* clock=*/ 18, /* data=*/ 23, /* CS=*/ 5, /* reset=*/ 22);
+// El objeto U8g2 de la pantalla vive en la HAL (Hal_esp32.cpp)
 
 // Instancia global del juego
 Juego pongGame; 
 
+// Semilla de la pelota. 0: una nueva de hardware en cada arranque; con
+// -D PINGPONG_SEMILLA=n la partida se repite igual (y igual que en el PC)
+#ifndef PINGPONG_SEMILLA
+#define PINGPONG_SEMILLA 0
+#endif
+
 // --------------------------------------------------------------------------
 // --- DEFINICIÓN DE LA VARIABLE GLOBAL RTC RAM (SECCIÓN RTC) ---
 RTC_DATA_ATTR RtcData_t rtc_game_state = {0x0000, 0, 0, STATE_TITLE_SCREEN, STATE_TITLE_SCREEN}; 
@@ -30,56 +36,139 @@ RTC_DATA_ATTR RtcData_t rtc_game_state = {0x0000, 0, 0, STATE_TITLE_SCREEN, STAT
 // ==========================================================
 //     *** CALLBACK DE RECEPCIÓN ESP-NOW ***
 // ==========================================================
-// Añade esta variable estática dentro de OnDataRecv en Main.cpp
+// Corre en la tarea WiFi: solo encola la muestra (Juego::recibirPaquete), sin
+// cerrojos, y la tarea de lógica la consume en su próximo paso.
 void OnDataRecv(const uint8_t * mac_addr, const uint8_t *incomingData, int len) {
-    // 1. Creamos una estructura temporal limpia
-    AccelData_t receivedData;
-    memset(&receivedData, 0, sizeof(receivedData));
-
-    // 2. Forzamos la copia de bytes (ignorando lo que crea el compilador del tamaño)
-    if (len >= 7) { 
-        memcpy(&receivedData, incomingData, 7); // Forzamos 7 bytes que es lo que envía el mando
-
-        portENTER_CRITICAL(&scoreMux);
-        
-        // DEBUG para ver qué llega exactamente
-
-        if (receivedData.player_id == 1) {
-            pongGame.remote_joy_y_val = receivedData.joy_y_val;
-            pongGame.remote_control_active = true;
-            pongGame.last_remote_packet = millis();
-            pongGame.remote_btn_pressed = receivedData.btn_pressed;
-        } 
-        else if (receivedData.player_id == 2) {
-            pongGame.remote_joy_y_val_j2 = receivedData.joy_y_val;
-            pongGame.remote_control_active_j2 = true;
-            pongGame.last_remote_packet_j2 = millis();
-            pongGame.remote_btn_pressed_j2 = receivedData.btn_pressed;
-        }
-        portEXIT_CRITICAL(&scoreMux);
-        
-        pongGame.last_activity_time = millis();
-    }
+    pongGame.recibirPaquete(incomingData, len);
 }
 // ==========================================================
 //     *** FUNCIONES DE TAREA DE FREERTOS ***
 // ==========================================================
 
 // --- Tarea de Lógica del Juego (Core 1 - Rápido) ---
+// Paso fijo: vTaskDelayUntil mantiene un periodo sin deriva y el acumulador
+// (PasoFijo) decide cuántos pasos de física tocan según micros(). Si una
+// iteración se retrasa, se recuperan hasta PINGPONG_MAX_PASOS_RECUPERACION pasos.
+//
+// Con -D PINGPONG_TICK_TEMPORIZADOR el paso lo marca un temporizador de
+// hardware (Timer 0 a 1 MHz) cuya interrupción notifica a esta tarea, que
+// corre con PRIORIDAD_LOGICA: el despertar no depende del tick de 1 ms de
+// FreeRTOS ni de las tareas de WiFi, y cada aviso es exactamente un paso.
+// El jitter del despertar se mide en ambos modos (comando serie 't').
+// Si un paso publica una imagen distinta, se despierta a Task_Dibujo.
+PasoFijo pasoLogica(PINGPONG_TICK_HZ);
+MedidorJitter jitterLogica(1000000UL / PINGPONG_TICK_HZ);
+
+#ifdef PINGPONG_TICK_TEMPORIZADOR
+const UBaseType_t PRIORIDAD_LOGICA = 10; // Sobre todo lo demás del Core 1 (loopTask = 1)
+static hw_timer_t *temporizadorTick = NULL;
+
+static void IRAM_ATTR alVencerTick() {
+    BaseType_t despertar = pdFALSE;
+    vTaskNotifyGiveFromISR(xTaskLogicaJuegoHandle, &despertar);
+    if (despertar) portYIELD_FROM_ISR();
+}
+
+// La interrupción queda en el núcleo que la registra: llamarla desde la tarea de lógica
+static void iniciarTemporizadorTick() {
+    temporizadorTick = timerBegin(0, 80, true); // 80 MHz / 80 = 1 MHz
+    timerAttachInterrupt(temporizadorTick, &alVencerTick, true);
+    timerAlarmWrite(temporizadorTick, 1000000UL / PINGPONG_TICK_HZ, true);
+    timerAlarmEnable(temporizadorTick);
+}
+#else
+const UBaseType_t PRIORIDAD_LOGICA = 1;
+#endif
+
 void Task_LogicaJuego(void *pvParameters) {
+#ifdef PINGPONG_TICK_TEMPORIZADOR
+    iniciarTemporizadorTick();
+#else
+    // Con el tick de FreeRTOS a 1 kHz: 5 ticks a 200 Hz, 2 a 500 Hz, 1 a 1000 Hz
+    const TickType_t periodo = (configTICK_RATE_HZ / PINGPONG_TICK_HZ) > 0 ? (configTICK_RATE_HZ / PINGPONG_TICK_HZ) : 1;
+    TickType_t ultimo_despertar = xTaskGetTickCount();
+#endif
+    pasoLogica.reiniciar(hal::micros());
+
     for (;;) {
-        // Llama al método de la instancia global del juego
-        pongGame.actualizarLogica();
-        vTaskDelay(pdMS_TO_TICKS(5)); // Lógica rápida (200 Hz)
+        if (pongGame.enReposo()) {
+            // IDLE: una revisión de actividad a 10 Hz, sin acumular pasos de física.
+            // Un botón despierta a la tarea en el acto (interrupción, hal::esperarReposo)
+#ifdef PINGPONG_TICK_TEMPORIZADOR
+            timerAlarmDisable(temporizadorTick); // Sin interrupciones a 200 Hz en reposo
+#endif
+            pongGame.perfil_logica.inicio();
+            if (pongGame.actualizarLogica()) xTaskNotifyGive(xTaskDibujoHandle);
+            pongGame.perfil_logica.fin();
+            hal::esperarReposo(PERIODO_REPOSO_MS);
+#ifdef PINGPONG_TICK_TEMPORIZADOR
+            ulTaskNotifyTake(pdTRUE, 0); // Descarta avisos viejos
+            timerWrite(temporizadorTick, 0);
+            timerAlarmEnable(temporizadorTick);
+#else
+            ultimo_despertar = xTaskGetTickCount();
+#endif
+            pasoLogica.reiniciar(hal::micros());
+            jitterLogica.reiniciar();
+            continue;
+        }
+
+#ifdef PINGPONG_TICK_TEMPORIZADOR
+        // Un aviso por periodo; si la tarea se atrasó, llegan varios juntos
+        uint32_t ticks = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        jitterLogica.registrar(hal::micros());
+        pongGame.perfil_logica.inicio();
+        int pasos = pasoLogica.pasosPorTicks(ticks);
+#else
+        vTaskDelayUntil(&ultimo_despertar, periodo);
+        jitterLogica.registrar(hal::micros());
+
+        // Llama al método de la instancia global del juego una vez por paso pendiente
+        pongGame.perfil_logica.inicio();
+        int pasos = pasoLogica.pasosPendientes(hal::micros());
+#endif
+        bool hay_cambios = false;
+        for (int i = 0; i < pasos && !pongGame.enReposo(); i++) {
+            hay_cambios = pongGame.actualizarLogica() || hay_cambios;
+        }
+        if (hay_cambios) xTaskNotifyGive(xTaskDibujoHandle);
+        if (pongGame.audio.hayEventos()) xTaskNotifyGive(xTaskAudioHandle);
+        pongGame.perfil_logica.fin();
     }
 }
 
 // --- Tarea de Dibujo (Core 0) ---
+// Duerme hasta que la lógica publique una imagen distinta (notificación) y
+// dibuja como mucho PINGPONG_FPS_MAX frames por segundo: los avisos que llegan
+// durante la espera se juntan en uno. En los menús quietos no se despierta y
+// el Core 0 queda para el WiFi. Con el HUD activo refresca igual cada 250 ms.
+// perfil_dibujo mide dibujo + envío/espera del bus: sirve para comparar el
+// transporte DMA con el bit-banging (-D PINGPONG_SPI_SOFTWARE).
 void Task_Dibujo(void *pvParameters) {
+    const TickType_t periodo = pdMS_TO_TICKS(1000 / PINGPONG_FPS_MAX) > 0 ? pdMS_TO_TICKS(1000 / PINGPONG_FPS_MAX) : 1;
+    TickType_t inicio_frame = xTaskGetTickCount();
     for (;;) {
         // Llama al método de la instancia global del juego para dibujar
+        pongGame.perfil_dibujo.inicio();
         pongGame.dibujarPantalla();
-        vTaskDelay(pdMS_TO_TICKS(1)); // Ceder el control por 1 ms
+        pongGame.perfil_dibujo.fin();
+
+        TickType_t transcurrido = xTaskGetTickCount() - inicio_frame;
+        if (transcurrido < periodo) vTaskDelay(periodo - transcurrido);
+
+        TickType_t espera = pongGame.hud_activo ? pdMS_TO_TICKS(250) : portMAX_DELAY;
+        ulTaskNotifyTake(pdTRUE, espera);
+        inicio_frame = xTaskGetTickCount();
+    }
+}
+
+// --- Tarea de Audio (Core 0, baja prioridad) ---
+// Toca los eventos que publica la física (Audio.h). Duerme hasta el fin de la
+// nota en curso o, en silencio, hasta que la tarea de lógica la despierte.
+void Task_Audio(void *pvParameters) {
+    for (;;) {
+        uint32_t espera_ms = pongGame.audio.procesar(millis());
+        ulTaskNotifyTake(pdTRUE, espera_ms == Audio::SIN_ESPERA ? portMAX_DELAY : pdMS_TO_TICKS(espera_ms));
     }
 }
 
@@ -87,15 +176,13 @@ void Task_Dibujo(void *pvParameters) {
 void print_wakeup_reason(){
     esp_sleep_wakeup_cause_t wakeup_reason = esp_sleep_get_wakeup_cause();
 
-    Serial.print("Causa del Despertar: ");
-
     switch(wakeup_reason){
-        case ESP_SLEEP_WAKEUP_EXT0 : Serial.println("Despertado por EXT0 (Pin)"); break;
-        case ESP_SLEEP_WAKEUP_EXT1 : Serial.println("Despertado por EXT1 (Pines RTC: Boton/Joystick)"); break; 
-        case ESP_SLEEP_WAKEUP_TIMER : Serial.println("Despertado por Timer (Tiempo agotado)"); break;
-        case ESP_SLEEP_WAKEUP_ULP : Serial.println("Despertado por ULP"); break;
-        case ESP_SLEEP_WAKEUP_UNDEFINED : Serial.println("Reinicio normal (Power-On o Reset)"); break;
-        default : Serial.printf("Despertado por: %d\n", wakeup_reason); break;
+        case ESP_SLEEP_WAKEUP_EXT0 : REGISTRO_INFO("Causa del Despertar: Despertado por EXT0 (Pin)"); break;
+        case ESP_SLEEP_WAKEUP_EXT1 : REGISTRO_INFO("Causa del Despertar: Despertado por EXT1 (Pines RTC: Boton/Joystick)"); break; 
+        case ESP_SLEEP_WAKEUP_TIMER : REGISTRO_INFO("Causa del Despertar: Despertado por Timer (Tiempo agotado)"); break;
+        case ESP_SLEEP_WAKEUP_ULP : REGISTRO_INFO("Causa del Despertar: Despertado por ULP"); break;
+        case ESP_SLEEP_WAKEUP_UNDEFINED : REGISTRO_INFO("Causa del Despertar: Reinicio normal (Power-On o Reset)"); break;
+        default : REGISTRO_INFO("Causa del Despertar: Despertado por: %d", wakeup_reason); break;
     }
 }
 
@@ -103,20 +190,22 @@ void setup() {
     Serial.begin(115200); 
     // AGREGAR: Esperar un momento para que el monitor serial se conecte y se establezca el baud rate.
     delay(500); 
-    Serial.println("--- Sistema Iniciado ---");
+    // Desde aquí los mensajes salen por la tarea del registro (Registro.h), sin bloquear
+    registro::iniciar();
+    REGISTRO_INFO("--- Sistema Iniciado ---");
     // 1. Verificar la causa del despertar antes de inicializar todo
     esp_sleep_wakeup_cause_t wakeup_reason = esp_sleep_get_wakeup_cause();
     print_wakeup_reason();
 
     // 2. Inicializar la pantalla primero (Core 0)
-    u8g2.begin();
-    u8g2.setPowerSave(0); 
+    hal::pantalla.begin();
+    hal::pantalla.setPowerSave(0); 
     delay(10); // Pausa mínima para que la pantalla inicie
 
     // --- LÓGICA DE RECUPERACIÓN DE ESTADO RTC ---
     if (wakeup_reason == ESP_SLEEP_WAKEUP_EXT1 || wakeup_reason == ESP_SLEEP_WAKEUP_TIMER) {
         if (rtc_game_state.magic_check == 0xDEAF) {
-            Serial.println("Recuperando estado de RTC RAM...");
+            REGISTRO_INFO("Recuperando estado de RTC RAM...");
             
             pongGame.score_p1 = rtc_game_state.score_p1;
             pongGame.score_p2 = rtc_game_state.score_p2;
@@ -131,19 +220,49 @@ void setup() {
             }
             
             rtc_game_state.magic_check = 0;
+            pongGame.publicarInstantanea(); // Que el primer frame ya muestre el estado recuperado
         }
     }
     // --- FIN LÓGICA DE RECUPERACIÓN ---
     
-    // Inicializar el generador de números aleatorios para la pelota
-    randomSeed(esp_random()); 
+    // Inicializar el generador de números aleatorios para la pelota. La semilla
+    // se informa para repetir la partida en el PC (program <segundos> <semilla>)
+    uint32_t semilla = PINGPONG_SEMILLA ? PINGPONG_SEMILLA : hal::semillaHardware();
+    hal::semillaAleatoria(semilla);
+    REGISTRO_INFO("Semilla de la pelota: %u", (unsigned)semilla);
     
     // Configuración de pines de entrada
-    pinMode(pongGame.PIN_JOYSTICK_1_Y, INPUT_PULLUP); 
-    pinMode(pongGame.PIN_JOYSTICK_2_Y, INPUT_PULLUP);
-    pinMode(pongGame.PIN_BUTTON_1, INPUT_PULLUP); 
-    pinMode(pongGame.PIN_BUTTON_2, INPUT_PULLUP);
-    pinMode(PIN_BUZZER, OUTPUT); 
+    hal::configurarEntrada(pongGame.PIN_JOYSTICK_1_Y); 
+    hal::configurarEntrada(pongGame.PIN_JOYSTICK_2_Y);
+    hal::configurarBoton(pongGame.PIN_BUTTON_1); // Interrupción: solo genera eventos al cambiar
+    hal::configurarBoton(pongGame.PIN_BUTTON_2);
+    hal::configurarSalida(PIN_BUZZER); 
+
+    // Calibración de los ejes guardada en NVS (Calibracion.h). Encender con los
+    // dos botones presionados la rehace; al despertar no, porque EXT1 exige
+    // justamente los dos botones abajo.
+    if (pongGame.calibracion.cargar()) {
+        REGISTRO_INFO("Calibracion de los ejes cargada de NVS");
+    }
+    if (wakeup_reason != ESP_SLEEP_WAKEUP_EXT1 &&
+        hal::leerGPIO(pongGame.PIN_BUTTON_1) == hal::NIVEL_BAJO &&
+        hal::leerGPIO(pongGame.PIN_BUTTON_2) == hal::NIVEL_BAJO) {
+        pongGame.calibracion_pedida = true;
+    }
+
+#if PINGPONG_ADC_CONTINUO
+    // Los joysticks locales pasan a muestrearse por DMA; leerADC() ya no convierte en el tick
+    const int pinesJoystick[] = { pongGame.PIN_JOYSTICK_1_Y, pongGame.PIN_JOYSTICK_2_Y };
+    if (!AdcContinuo::iniciar(pinesJoystick, 2)) {
+        REGISTRO_AVISO("ADC continuo no disponible; se usa analogRead()");
+    }
+#endif
+
+#ifdef PINGPONG_BENCH
+    // Modo benchmark: mide el tick en este núcleo (loopTask, Core 1) y no arranca el juego
+    Benchmark::ejecutarTodos(pongGame);
+    return;
+#endif
     
     // 3. Crear las tareas de FreeRTOS del JUEGO (Prioridad: alta/normal)
     xTaskCreatePinnedToCore(
@@ -151,7 +270,7 @@ void setup() {
         "LogicaJuego", 
         4096, 
         NULL, 
-        1, // Prioridad 1 (Normal)
+        PRIORIDAD_LOGICA, // 1 (Normal), o alta con PINGPONG_TICK_TEMPORIZADOR
         &xTaskLogicaJuegoHandle, 
         1 // Core 1 (Lógica)
     );
@@ -165,26 +284,155 @@ void setup() {
         &xTaskDibujoHandle, 
         0 // Core 0 (Dibujo)
     );
+
+    xTaskCreatePinnedToCore(
+        Task_Audio,
+        "Audio",
+        2048,
+        NULL,
+        0, // Prioridad 0: por debajo del dibujo y del WiFi (como IDLE, por turnos)
+        &xTaskAudioHandle,
+        0 // Core 0
+    );
     // ----------------------------------------------------------------------
     // 💡 PASO 4. INICIALIZACIÓN DE ESP-NOW (MOVIDO DESDE EL TASK)
     // ----------------------------------------------------------------------
-    Serial.println("Inicializando WiFi/ESP-NOW en setup().");
+    REGISTRO_INFO("Inicializando WiFi/ESP-NOW en setup().");
     
     // Inicialización del WiFi 
     WiFi.mode(WIFI_STA); 
-    Serial.print("MAC Address: ");
-    Serial.println(WiFi.macAddress());
-    Serial.flush(); // Garantiza que la MAC se imprima
+    REGISTRO_INFO("MAC Address: %s", WiFi.macAddress().c_str());
 
     if (esp_now_init() != ESP_OK) {
-        Serial.println("Error inicializando ESP-NOW");
+        REGISTRO_ERROR("Error inicializando ESP-NOW");
     } else {
         // Una vez inicializado, establece el callback de recepción
         esp_now_register_recv_cb(OnDataRecv);
-        Serial.println("ESP-NOW inicializado y receptor registrado.");
+        REGISTRO_INFO("ESP-NOW inicializado y receptor registrado.");
+    }
+}
+
+// --- Informe periódico de la calidad del enlace de cada mando ---
+static void reportarEnlace(int jugador) {
+    const EstadisticasEnlace &e = (jugador == 1) ? pongGame.enlace_j1 : pongGame.enlace_j2;
+    if (e.recibidas == 0) return; // Mando no conectado
+    Serial.printf("[enlace J%d] recibidas %u | perdidas %u (%u.%u%%), recuperadas %u | fuera de orden %u | jitter %u us | max hueco %u ms | cola llena %u\n",
+                  jugador, (unsigned)e.recibidas, (unsigned)e.perdidas,
+                  (unsigned)(e.perdidaPorMil() / 10), (unsigned)(e.perdidaPorMil() % 10), (unsigned)e.recuperadas,
+                  (unsigned)e.fuera_de_orden, (unsigned)e.jitterUs(),
+                  (unsigned)(e.max_entre_llegadas_us / 1000),
+                  (unsigned)pongGame.descartesColaRemota(jugador));
+}
+
+// --- Perfil de las tareas, carga de cada núcleo y pila libre ---
+// La carga por núcleo sale del tiempo de las tareas IDLE de FreeRTOS
+// (run-time stats); si el sdkconfig no las trae, se informa solo la
+// ocupación que mide PerfilTarea para cada tarea.
+static void reportarTareas() {
+    pongGame.perfil_logica.imprimir("LogicaJuego");
+    pongGame.perfil_dibujo.imprimir("Dibujo");
+#ifdef PINGPONG_TICK_TEMPORIZADOR
+    jitterLogica.imprimir("temporizador");
+#else
+    jitterLogica.imprimir("vTaskDelayUntil");
+#endif
+    Serial.printf("[tick] pasos simulados %u | descartados %u | iteraciones con recuperacion %u\n",
+                  (unsigned)pasoLogica.pasos_simulados, (unsigned)pasoLogica.pasos_descartados,
+                  (unsigned)pasoLogica.iteraciones_con_recuperacion);
+#if PINGPONG_ADC_CONTINUO
+    Serial.printf("[adc] bloques %u | desbordes %u\n",
+                  (unsigned)AdcContinuo::bloques, (unsigned)AdcContinuo::desbordes);
+#endif
+    Serial.printf("[registro] descartados %u (cola llena)\n", (unsigned)registro::descartados());
+
+#if (configGENERATE_RUN_TIME_STATS == 1) && (configUSE_TRACE_FACILITY == 1)
+    static const UBaseType_t MAX_TAREAS = 24;
+    static TaskStatus_t estados[MAX_TAREAS];
+    static uint32_t idle_previo[portNUM_PROCESSORS] = {0};
+    static uint32_t total_previo = 0;
+
+    uint32_t total = 0;
+    UBaseType_t n = uxTaskGetSystemState(estados, MAX_TAREAS, &total);
+    uint32_t delta_total = total - total_previo;
+    if (n > 0 && delta_total > 0) {
+        char linea[96];
+        size_t largo = snprintf(linea, sizeof(linea), "[perfil] carga:");
+        for (int nucleo = 0; nucleo < portNUM_PROCESSORS; nucleo++) {
+            TaskHandle_t idle = xTaskGetIdleTaskHandleForCPU(nucleo);
+            for (UBaseType_t i = 0; i < n; i++) {
+                if (estados[i].xHandle != idle) continue;
+                uint32_t delta_idle = estados[i].ulRunTimeCounter - idle_previo[nucleo];
+                idle_previo[nucleo] = estados[i].ulRunTimeCounter;
+                uint32_t carga = delta_idle < delta_total ? 100 - (uint32_t)((uint64_t)delta_idle * 100 / delta_total) : 0;
+                largo += snprintf(linea + largo, sizeof(linea) - largo, " Core %d %u%%", nucleo, (unsigned)carga);
+            }
+        }
+        snprintf(linea + largo, sizeof(linea) - largo, " (desde el informe anterior)");
+        hal::log(linea); // Una sola escritura (Registro.h)
+        total_previo = total;
+    }
+#else
+    hal::log("[perfil] carga por núcleo: requiere CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS");
+#endif
+
+    // En ESP-IDF la pila se mide en bytes
+    Serial.printf("[perfil] pila libre minima: LogicaJuego %u B | Dibujo %u B | loop %u B\n",
+                  (unsigned)uxTaskGetStackHighWaterMark(xTaskLogicaJuegoHandle),
+                  (unsigned)uxTaskGetStackHighWaterMark(xTaskDibujoHandle),
+                  (unsigned)uxTaskGetStackHighWaterMark(NULL));
+}
+
+// --- Comandos por el monitor serie ---
+//   l : latencia mando -> pantalla por etapas (resumen)
+//   h : lo mismo con las cubetas de cada histograma
+//   r : vacía los histogramas de latencia
+//   t : perfil de las tareas, carga por núcleo y pila libre
+//   d : muestra/oculta el HUD de depuración en la pantalla
+//   c : entra al modo calibración de los ejes
+//   k : imprime la calibración actual
+//   v : activa/desactiva las trazas binarias del registro (muestras, botones, frames)
+static void atenderComandos() {
+    while (Serial.available() > 0) {
+        switch (Serial.read()) {
+            case 'l': pongGame.latencia.imprimir(false); break;
+            case 'h': pongGame.latencia.imprimir(true); break;
+            case 'r':
+                pongGame.latencia.reiniciar();
+                hal::log("[latencia] histogramas vaciados");
+                break;
+            case 't': reportarTareas(); break;
+            case 'd':
+#if PINGPONG_PERFIL
+                pongGame.hud_activo = !pongGame.hud_activo;
+                xTaskNotifyGive(xTaskDibujoHandle); // Que aparezca/desaparezca ya
+#else
+                hal::log("[perfil] desactivado al compilar (PINGPONG_PERFIL=0)");
+#endif
+                break;
+            case 'c': pongGame.calibracion_pedida = true; break;
+            case 'k': pongGame.calibracion.imprimir(); break;
+            case 'v':
+#if PINGPONG_TRAZAS
+                registro::activarTrazas(!registro::trazasActivas());
+                Serial.printf("[registro] trazas %s\n", registro::trazasActivas() ? "activas" : "apagadas");
+#else
+                hal::log("[registro] trazas quitadas al compilar (PINGPONG_TRAZAS=0)");
+#endif
+                break;
+            default: break;
+        }
     }
 }
 
 void loop() {
-    // El loop principal se deja vacío para la gestión de tareas de FreeRTOS
+    // Las tareas de FreeRTOS hacen todo el trabajo; aquí se atienden los
+    // comandos serie y se informa cada 10 s cómo va el enlace de los mandos
+    static uint32_t ultimo_reporte_ms = 0;
+    vTaskDelay(pdMS_TO_TICKS(100));
+    atenderComandos();
+    if (millis() - ultimo_reporte_ms >= 10000) {
+        ultimo_reporte_ms = millis();
+        reportarEnlace(1);
+        reportarEnlace(2);
+    }
 }
\ No newline at end of file
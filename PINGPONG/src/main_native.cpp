@@ -0,0 +1,161 @@
+// src/main_native.cpp
+// Punto de entrada del entorno nativo (env:native): ejecuta la lógica completa
+// del juego en el PC con el reloj virtual de la HAL. Simula una partida
+// VS MAQUINA en la que el Jugador 1 sigue la pelota con el joystick local.
+//
+// Uso: program [segundos_simulados] [semilla] [--frame]
+// Con PINGPONG_BENCH (env:native_bench) ejecuta los microbenchmarks y con
+// PINGPONG_SIM_ENLACE (env:native_enlace) la medición de latencia del mando
+// sobre un enlace ESP-NOW simulado (SimEnlace.h).
+
+#include "Juego.h"
+#include "Benchmark.h"
+#include "SimEnlace.h"
+#include "PasoFijo.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Mismas globales que define main.cpp en el ESP32
+RtcData_t rtc_game_state = {0x0000, 0, 0, STATE_TITLE_SCREEN, STATE_TITLE_SCREEN};
+Juego pongGame;
+
+// En 'pio test -e native' el main() es el de cada prueba (test/)
+#ifndef PIO_UNIT_TESTING
+
+static PasoFijo pasoLogica(PINGPONG_TICK_HZ);
+static const uint32_t PERIODO_LOGICA_US = 1000000UL / PINGPONG_TICK_HZ;
+static const uint32_t PERIODO_DIBUJO_US = 1000000UL / PINGPONG_FPS_MAX;
+
+static uint32_t reloj_dibujo_us = PERIODO_DIBUJO_US;
+static bool dibujo_notificado = true;
+
+// Un paso de la tarea de lógica, con el mismo acumulador de paso fijo que
+// Task_LogicaJuego, y un frame si la imagen cambió y ya pasó el periodo de
+// dibujo (como la notificación y el ritmo de Task_Dibujo)
+static void tick() {
+    hal::sim::avanzarReloj(PERIODO_LOGICA_US);
+    int pasos = pasoLogica.pasosPendientes(hal::micros());
+    for (int i = 0; i < pasos; i++) {
+        dibujo_notificado = pongGame.actualizarLogica() || dibujo_notificado;
+    }
+    pongGame.audio.procesar(hal::millis());
+    if (reloj_dibujo_us < PERIODO_DIBUJO_US) reloj_dibujo_us += PERIODO_LOGICA_US;
+    if (dibujo_notificado && reloj_dibujo_us >= PERIODO_DIBUJO_US) {
+        reloj_dibujo_us = 0;
+        dibujo_notificado = false;
+        pongGame.dibujarPantalla();
+    }
+}
+
+static void esperarTicks(int n) {
+    for (int i = 0; i < n; i++) tick();
+}
+
+// Presiona y suelta el Botón 1 (activo en bajo)
+static void pulsarBoton1() {
+    hal::sim::fijarGPIO(pongGame.PIN_BUTTON_1, hal::NIVEL_BAJO);
+    esperarTicks(2);
+    hal::sim::fijarGPIO(pongGame.PIN_BUTTON_1, hal::NIVEL_ALTO);
+    esperarTicks(2);
+}
+
+// Mueve el joystick 1 abajo durante un paso de navegación del menú
+static void bajarMenu() {
+    hal::sim::fijarADC(pongGame.PIN_JOYSTICK_1_Y, 4095);
+    esperarTicks(150 * PINGPONG_TICK_HZ / 1000); // 150 ms > MENU_MOVE_DELAY
+    hal::sim::fijarADC(pongGame.PIN_JOYSTICK_1_Y, 2048);
+    esperarTicks(150 * PINGPONG_TICK_HZ / 1000); // 150 ms > MENU_MOVE_DELAY
+}
+
+static void imprimirFrame() {
+    const hal::Pantalla &p = hal::pantalla;
+    for (int y = 0; y < hal::Pantalla::ALTO; y++) {
+        for (int x = 0; x < hal::Pantalla::ANCHO; x++) {
+            bool on = p.buffer[y * (hal::Pantalla::ANCHO / 8) + (x >> 3)] & (0x80 >> (x & 7));
+            putchar(on ? '#' : '.');
+        }
+        putchar('\n');
+    }
+}
+
+int main(int argc, char **argv) {
+#ifdef PINGPONG_SIM_ENLACE
+    hal::pantalla.begin();
+    return SimEnlace::ejecutar(pongGame, argc, argv);
+#endif
+
+    int segundos = 60;
+    uint32_t semilla = 1234;
+    bool mostrar_frame = false;
+    int posicional = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--frame") == 0) {
+            mostrar_frame = true;
+        } else if (posicional == 0) {
+            segundos = atoi(argv[i]);
+            posicional++;
+        } else {
+            semilla = (uint32_t)strtoul(argv[i], NULL, 10);
+        }
+    }
+
+    hal::pantalla.begin();
+    hal::configurarBoton(pongGame.PIN_BUTTON_1);
+    hal::configurarBoton(pongGame.PIN_BUTTON_2);
+
+#ifdef PINGPONG_BENCH
+    Benchmark::ejecutarTodos(pongGame);
+    return 0;
+#endif
+
+    hal::semillaAleatoria(semilla);
+    pasoLogica.reiniciar(hal::micros());
+
+    // Título -> Selección -> VS MAQUINA -> Dificultad NORMAL
+    pulsarBoton1();
+    bajarMenu();
+    pulsarBoton1();
+    bajarMenu();
+    pulsarBoton1();
+
+    if (pongGame.gameState != STATE_VS_AI) {
+        printf("Error: el menu no llego a STATE_VS_AI (estado=%d)\n", (int)pongGame.gameState);
+        return 1;
+    }
+
+    // El Jugador 1 sigue la pelota: convierte su Y en el valor del joystick
+    const int ticks_totales = segundos * 1000000 / (int)PERIODO_LOGICA_US;
+    int ticks = 0;
+    for (; ticks < ticks_totales && pongGame.gameState == STATE_VS_AI; ticks++) {
+        int objetivo = escalarAEntero(pongGame.pelota.y) - pongGame.paleta1.ALTO / 2;
+        objetivo = hal::limitar(objetivo, 0, 64 - pongGame.paleta1.ALTO);
+        hal::sim::fijarADC(pongGame.PIN_JOYSTICK_1_Y, objetivo * 4095 / (64 - pongGame.paleta1.ALTO));
+        tick();
+    }
+
+    printf("Pasos simulados: %d a %d Hz (%.1f s)\n", ticks, PINGPONG_TICK_HZ, ticks * (PERIODO_LOGICA_US / 1e6));
+    printf("Estado final: %d | Marcador J1 %d - %d J2\n",
+           (int)pongGame.gameState, pongGame.score_p1, pongGame.score_p2);
+    printf("Pelota: x=%.4f y=%.4f vx=%.4f vy=%.4f\n",
+           escalarAFloat(pongGame.pelota.x), escalarAFloat(pongGame.pelota.y),
+           escalarAFloat(pongGame.pelota.velocidad_x), escalarAFloat(pongGame.pelota.velocidad_y));
+
+    printf("Audio: %u eventos tocados, %u descartados (cola llena)\n",
+           (unsigned)pongGame.audio.eventosTocados(), (unsigned)pongGame.audio.eventosDescartados());
+
+    const DiffST7920 &d = hal::pantalla.diff;
+    if (d.frames > 0) {
+        printf("Pantalla: %u frames, %.1f bytes/frame de GDRAM enviados (frame completo: %d)\n",
+               (unsigned)d.frames, (double)d.bytes_totales / d.frames, DiffST7920::BYTES_FRAME);
+    }
+
+    if (mostrar_frame) {
+        pongGame.dibujarPantalla();
+        imprimirFrame();
+    }
+    return 0;
+}
+
+#endif // PIO_UNIT_TESTING
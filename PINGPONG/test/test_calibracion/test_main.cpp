@@ -0,0 +1,76 @@
+// test/test_calibracion/test_main.cpp
+//
+// --- PRUEBAS DE EjeCalibrado (pio test -e native) ---
+// La tabla solo linealiza; la zona muerta y los extremos los pone recortar().
+
+#include <unity.h>
+#include "Calibracion.h"
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_fabrica_es_la_identidad(void) {
+    EjeCalibrado eje;
+    for (int crudo = 8; crudo < EJE_MAXIMO; crudo += 16) {
+        TEST_ASSERT_INT_WITHIN(1, crudo, eje.linealizar(crudo));
+    }
+}
+
+// Un joystick descentrado: 300 / 1800 / 3900 crudos
+void test_puntos_medidos_van_a_la_escala_del_juego(void) {
+    EjeCalibrado eje;
+    const PuntosEje p = { 300, 1800, 3900 };
+    TEST_ASSERT_TRUE(eje.construir(p));
+    TEST_ASSERT_INT_WITHIN(20, 0, eje.linealizar(300));
+    TEST_ASSERT_INT_WITHIN(20, EJE_CENTRO, eje.linealizar(1800));
+    TEST_ASSERT_INT_WITHIN(20, EJE_MAXIMO, eje.linealizar(3900));
+    TEST_ASSERT_EQUAL_INT(0, eje.linealizar(0));
+    TEST_ASSERT_EQUAL_INT(EJE_MAXIMO, eje.linealizar(4095));
+}
+
+// La tabla es continua alrededor del centro: sin escalón de la zona muerta
+void test_linealizar_no_tiene_zona_muerta(void) {
+    EjeCalibrado eje;
+    int anterior = eje.linealizar(0);
+    for (int crudo = 16; crudo <= EJE_MAXIMO; crudo += 16) {
+        int v = eje.linealizar(crudo);
+        TEST_ASSERT_TRUE(v >= anterior);
+        TEST_ASSERT_TRUE(v - anterior <= 20);
+        anterior = v;
+    }
+}
+
+void test_recortar(void) {
+    TEST_ASSERT_EQUAL_INT(EJE_CENTRO, EjeCalibrado::recortar(EJE_CENTRO + EJE_ZONA_MUERTA - 1));
+    TEST_ASSERT_EQUAL_INT(EJE_CENTRO, EjeCalibrado::recortar(EJE_CENTRO - EJE_ZONA_MUERTA + 1));
+    TEST_ASSERT_EQUAL_INT(EJE_CENTRO + EJE_ZONA_MUERTA, EjeCalibrado::recortar(EJE_CENTRO + EJE_ZONA_MUERTA));
+    TEST_ASSERT_EQUAL_INT(0, EjeCalibrado::recortar(EJE_MARGEN_EXTREMO - 1));
+    TEST_ASSERT_EQUAL_INT(EJE_MAXIMO, EjeCalibrado::recortar(EJE_MAXIMO - EJE_MARGEN_EXTREMO + 1));
+    TEST_ASSERT_EQUAL_INT(1000, EjeCalibrado::recortar(1000));
+}
+
+void test_recorrido_insuficiente_no_cambia_la_tabla(void) {
+    EjeCalibrado eje;
+    const PuntosEje p = { 1800, 2048, 2300 };
+    TEST_ASSERT_FALSE(eje.construir(p));
+    TEST_ASSERT_EQUAL_INT(0, eje.puntos().minimo);
+    TEST_ASSERT_INT_WITHIN(1, 1000, eje.linealizar(1000));
+}
+
+// Umbrales del menú de siempre: arriba por debajo de 1500, abajo por encima de 2500
+void test_umbrales_del_menu(void) {
+    TEST_ASSERT_EQUAL_INT(1500, EJE_CENTRO - EJE_UMBRAL_MENU_SUBE);
+    TEST_ASSERT_EQUAL_INT(2500, EJE_CENTRO + EJE_UMBRAL_MENU_BAJA);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_fabrica_es_la_identidad);
+    RUN_TEST(test_puntos_medidos_van_a_la_escala_del_juego);
+    RUN_TEST(test_linealizar_no_tiene_zona_muerta);
+    RUN_TEST(test_recortar);
+    RUN_TEST(test_recorrido_insuficiente_no_cambia_la_tabla);
+    RUN_TEST(test_umbrales_del_menu);
+    return UNITY_END();
+}
@@ -0,0 +1,130 @@
+// test/test_enlace_simulado/test_main.cpp
+//
+// --- PRUEBAS DE EnlaceSimulado (pio test -e native) ---
+// Estadísticas del modelo de pérdidas (Gilbert) sobre muchas tramas, y
+// latencia y orden de entrega.
+
+#include <unity.h>
+#include <string.h>
+#include "EnlaceSimulado.h"
+
+static const int TRAMAS = 100000;
+static const uint32_t PERIODO_US = 5000;
+
+static EnlaceSimulado enlace;
+static int recibidas;
+static uint8_t ultimo_recibido;
+
+static void receptor(const uint8_t *datos, int len) {
+    (void)len;
+    recibidas++;
+    ultimo_recibido = datos[0];
+}
+
+struct Estadistica {
+    int perdidas;
+    float perdida;              // Fracción de tramas perdidas
+    float perdida_tras_perdida; // Fracción de las que siguen a una perdida
+    int maxima_racha;
+    int rechazadas;             // enviar() devolvió false
+};
+
+static Estadistica medir(const EnlaceSimulado::Config &config) {
+    enlace.configurar(config);
+    enlace.fijarReceptor(receptor);
+    Estadistica e = { 0, 0.0f, 0.0f, 0, 0 };
+    int tras_perdida = 0, perdidas_tras_perdida = 0, racha = 0;
+    bool anterior_perdida = false;
+    uint8_t dato = 0;
+    for (int i = 0; i < TRAMAS; i++) {
+        uint32_t ahora_us = i * PERIODO_US;
+        uint32_t antes = enlace.perdidas;
+        if (!enlace.enviar(&dato, 1, ahora_us)) e.rechazadas++;
+        bool perdida = enlace.perdidas != antes;
+        enlace.entregar(ahora_us + config.latencia_us);
+
+        if (perdida) e.perdidas++;
+        if (anterior_perdida) {
+            tras_perdida++;
+            if (perdida) perdidas_tras_perdida++;
+        }
+        racha = perdida ? racha + 1 : 0;
+        if (racha > e.maxima_racha) e.maxima_racha = racha;
+        anterior_perdida = perdida;
+    }
+    e.perdida = (float)e.perdidas / TRAMAS;
+    e.perdida_tras_perdida = tras_perdida ? (float)perdidas_tras_perdida / tras_perdida : 0.0f;
+    return e;
+}
+
+void setUp(void) {
+    recibidas = 0;
+}
+
+void tearDown(void) {}
+
+// Sin --rafaga las pérdidas son independientes
+void test_perdidas_independientes_por_defecto(void) {
+    EnlaceSimulado::Config config;
+    config.perdida = 0.2f;
+    Estadistica e = medir(config);
+    TEST_ASSERT_EQUAL_INT(0, e.rechazadas);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.2f, e.perdida);
+    TEST_ASSERT_FLOAT_WITHIN(0.015f, 0.2f, e.perdida_tras_perdida);
+    TEST_ASSERT_EQUAL_INT(TRAMAS - e.perdidas, recibidas);
+}
+
+// Gilbert: en régimen la pérdida es perdida / (perdida + 1 - rafaga)
+void test_rafaga_correlaciona_las_perdidas(void) {
+    EnlaceSimulado::Config config;
+    config.perdida = 0.2f;
+    config.rafaga = 0.6f;
+    Estadistica e = medir(config);
+    TEST_ASSERT_FLOAT_WITHIN(0.015f, 0.6f, e.perdida_tras_perdida);
+    TEST_ASSERT_FLOAT_WITHIN(0.015f, 0.2f / (0.2f + 1.0f - 0.6f), e.perdida);
+}
+
+void test_rafaga_cero_nunca_pierde_dos_seguidas(void) {
+    EnlaceSimulado::Config config;
+    config.perdida = 0.3f;
+    config.rafaga = 0.0f;
+    Estadistica e = medir(config);
+    TEST_ASSERT_EQUAL_INT(1, e.maxima_racha);
+}
+
+void test_misma_semilla_misma_secuencia(void) {
+    EnlaceSimulado::Config config;
+    config.perdida = 0.1f;
+    config.semilla = 77;
+    Estadistica a = medir(config);
+    Estadistica b = medir(config);
+    TEST_ASSERT_EQUAL_INT(a.perdidas, b.perdidas);
+    TEST_ASSERT_EQUAL_INT(a.maxima_racha, b.maxima_racha);
+}
+
+// Sin jitter ni desorden: cada trama llega justo a la latencia, en orden
+void test_entrega_a_la_latencia_y_en_orden(void) {
+    EnlaceSimulado::Config config;
+    config.latencia_us = 2000;
+    enlace.configurar(config);
+    enlace.fijarReceptor(receptor);
+    for (uint8_t i = 0; i < 3; i++) {
+        TEST_ASSERT_TRUE(enlace.enviar(&i, 1, 100 * i));
+    }
+    enlace.entregar(100 + 1999);
+    TEST_ASSERT_EQUAL_INT(1, recibidas);
+    TEST_ASSERT_EQUAL_INT(0, ultimo_recibido);
+    enlace.entregar(200 + 2000);
+    TEST_ASSERT_EQUAL_INT(3, recibidas);
+    TEST_ASSERT_EQUAL_INT(2, ultimo_recibido);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_perdidas_independientes_por_defecto);
+    RUN_TEST(test_rafaga_correlaciona_las_perdidas);
+    RUN_TEST(test_rafaga_cero_nunca_pierde_dos_seguidas);
+    RUN_TEST(test_misma_semilla_misma_secuencia);
+    RUN_TEST(test_entrega_a_la_latencia_y_en_orden);
+    return UNITY_END();
+}
@@ -0,0 +1,100 @@
+// test/test_pelota/test_main.cpp
+//
+// --- PRUEBAS DE LA COLISIÓN POR BARRIDO DE Pelota (pio test -e native) ---
+// Velocidades en píxeles por paso, elegidas para que los instantes de impacto
+// sean exactos también en Q16.16 (Fijo.h).
+
+#include <unity.h>
+#include "Pelota.h"
+#include "Paleta.h"
+
+// Paleta 1 como en Juego: x = 2, centrada (y = 25..39).
+// Su caja ampliada por la pelota (suma de Minkowski) es x -1..5, y 22..40.
+static Paleta paleta1(2);
+static Paleta paleta2(128 - 3 - 2);
+
+void setUp(void) {
+    paleta1 = Paleta(2);
+    paleta2 = Paleta(128 - 3 - 2);
+}
+
+void tearDown(void) {}
+
+static void colocar(Pelota &p, Escalar x, Escalar y, Escalar vx, Escalar vy) {
+    p.x = x;
+    p.y = y;
+    p.velocidad_x = vx;
+    p.velocidad_y = vy;
+}
+
+// 12 px por paso, el doble del ancho de la caja: sin barrido la pelota pasaría
+// de x = 8 a x = -4 sin llegar a superponerse con la paleta
+void test_pelota_rapida_no_atraviesa_la_paleta(void) {
+    Pelota p;
+    int s1 = 0, s2 = 0;
+    colocar(p, 8, 30, -12, 0);
+    p.actualizar(paleta1, paleta2, s1, s2);
+
+    // Impacto en x = 5 (t = 0.25) y el resto del paso hacia la derecha
+    TEST_ASSERT_EQUAL_INT(0, s2);
+    TEST_ASSERT_TRUE(p.velocidad_x > 0);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 14.0f, escalarAFloat(p.x));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 30.0f, escalarAFloat(p.y));
+}
+
+// Llega en diagonal justo a la esquina superior derecha de la caja (5, 22):
+// entra por X y por Y a la vez y cuenta como golpe de frente
+void test_golpe_en_la_esquina_rebota_de_frente(void) {
+    Pelota p;
+    int s1 = 0, s2 = 0;
+    colocar(p, 7, 20, -4, 4);
+    p.actualizar(paleta1, paleta2, s1, s2);
+
+    TEST_ASSERT_EQUAL_INT(0, s2);
+    TEST_ASSERT_TRUE(p.velocidad_x > 0);
+    TEST_ASSERT_TRUE(p.velocidad_y > 0);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 7.0f, escalarAFloat(p.x));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 24.0f, escalarAFloat(p.y));
+}
+
+// Ya sobre la paleta en X y cayendo sobre su canto superior
+// (y = 22, t = 0.75): sigue hacia la izquierda, sin un segundo rebote de
+// frente al salir del canto
+void test_golpe_en_el_canto_invierte_y(void) {
+    Pelota p;
+    int s1 = 0, s2 = 0;
+    colocar(p, 3, 16, escalarDe(-0.5), 8);
+    p.actualizar(paleta1, paleta2, s1, s2);
+
+    TEST_ASSERT_TRUE(p.velocidad_x < 0);
+    TEST_ASSERT_TRUE(p.velocidad_y < 0);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 20.0f, escalarAFloat(p.y));
+}
+
+// Entre los bordes (0 y 61) haría 16 rebotes en el paso: se resuelven
+// MAX_REBOTES_POR_PASO y el resto del paso se descarta con la pelota parada
+// sobre el último borde que tocó, ya con la velocidad invertida.
+void test_limite_de_rebotes_por_paso(void) {
+    Pelota p;
+    int s1 = 0, s2 = 0;
+    colocar(p, 64, 30, 0, 1000);
+    p.actualizar(paleta1, paleta2, s1, s2);
+
+    float y = escalarAFloat(p.y);
+    TEST_ASSERT_TRUE(y >= -0.01f && y <= 61.01f);
+    bool arriba = y < 1 && p.velocidad_y > 0;
+    bool abajo = y > 60 && p.velocidad_y < 0;
+    TEST_ASSERT_TRUE(arriba || abajo);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 64.0f, escalarAFloat(p.x));
+    TEST_ASSERT_EQUAL_INT(0, s1);
+    TEST_ASSERT_EQUAL_INT(0, s2);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_pelota_rapida_no_atraviesa_la_paleta);
+    RUN_TEST(test_golpe_en_la_esquina_rebota_de_frente);
+    RUN_TEST(test_golpe_en_el_canto_invierte_y);
+    RUN_TEST(test_limite_de_rebotes_por_paso);
+    return UNITY_END();
+}
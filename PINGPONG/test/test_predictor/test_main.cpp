@@ -0,0 +1,79 @@
+// test/test_predictor/test_main.cpp
+//
+// --- PRUEBAS DE PredictorMando (pio test -e native) ---
+// El mando manda una trama cada 10 ms con un tránsito fijo; la consola tiene
+// su reloj desfasado (los dos relojes no están sincronizados).
+
+#include <unity.h>
+#include "PredictorMando.h"
+#include "Protocolo.h"
+
+static const uint32_t PERIODO_US = 10000;
+static const uint32_t TRANSITO_US = 3000;
+static const uint32_t DESFASE_US = 1000000; // Reloj de la consola - reloj del mando
+
+static PredictorMando predictor;
+
+// Muestra k tomada en el mando, llegada con 'extra_us' de retraso sobre el
+// tránsito fijo y tras esperar 'espera_us' en el mando
+static void agregar(uint32_t k, int eje, uint32_t extra_us, uint32_t espera_us) {
+    uint32_t tomada_us = k * PERIODO_US;
+    uint32_t llegada_us = tomada_us + espera_us + TRANSITO_US + extra_us + DESFASE_US;
+    predictor.agregar(eje, protocolo::marcaDesdeUs(tomada_us), llegada_us, espera_us);
+}
+
+static uint32_t llegadaDe(uint32_t k) {
+    return k * PERIODO_US + TRANSITO_US + DESFASE_US;
+}
+
+void setUp(void) {
+    predictor.reiniciar();
+}
+
+void tearDown(void) {}
+
+void test_retardo_base_con_transito_constante(void) {
+    for (uint32_t k = 0; k < 10; k++) agregar(k, 2048, 0, 0);
+    TEST_ASSERT_EQUAL_UINT32(PINGPONG_LATENCIA_BASE_US, predictor.retardoUs());
+}
+
+void test_retardo_sigue_al_exceso_de_transito(void) {
+    for (uint32_t k = 0; k < 10; k++) agregar(k, 2048, 0, 0);
+    agregar(10, 2048, 2000, 0);
+    // El mínimo sube 1 us por muestra (deriva de los relojes)
+    TEST_ASSERT_INT_WITHIN(5, PINGPONG_LATENCIA_BASE_US + 2000, predictor.retardoUs());
+}
+
+// La trama 10 se pierde: la 11 trae su muestra y la 10 rehecha, que esperó un
+// periodo en el mando. Esa espera no es retardo de la radio.
+void test_retardo_no_cambia_tras_trama_perdida(void) {
+    for (uint32_t k = 0; k < 10; k++) agregar(k, 2048, 0, 0);
+    agregar(10, 2048, 0, PERIODO_US);
+    TEST_ASSERT_EQUAL_UINT32(PINGPONG_LATENCIA_BASE_US, predictor.retardoUs());
+    agregar(11, 2048, 0, 0);
+    TEST_ASSERT_EQUAL_UINT32(PINGPONG_LATENCIA_BASE_US, predictor.retardoUs());
+}
+
+// Rampa de 100 cuentas cada 10 ms: extrapola el retardo de la radio
+void test_estimar_extrapola_con_la_velocidad(void) {
+    for (uint32_t k = 0; k < 20; k++) agregar(k, 1000 + 100 * k, 0, 0);
+    TEST_ASSERT_INT_WITHIN(100, 10000, predictor.velocidad());
+    int esperado = 1000 + 100 * 19 + 10000 * (int)PINGPONG_LATENCIA_BASE_US / 1000000;
+    TEST_ASSERT_INT_WITHIN(2, esperado, predictor.estimar(llegadaDe(19)));
+}
+
+// Sin muestras nuevas durante varios intervalos el mando se detuvo
+void test_estimar_sin_muestras_no_extrapola(void) {
+    for (uint32_t k = 0; k < 20; k++) agregar(k, 1000 + 100 * k, 0, 0);
+    TEST_ASSERT_EQUAL_INT(1000 + 100 * 19, predictor.estimar(llegadaDe(19) + 100000));
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_retardo_base_con_transito_constante);
+    RUN_TEST(test_retardo_sigue_al_exceso_de_transito);
+    RUN_TEST(test_retardo_no_cambia_tras_trama_perdida);
+    RUN_TEST(test_estimar_extrapola_con_la_velocidad);
+    RUN_TEST(test_estimar_sin_muestras_no_extrapola);
+    return UNITY_END();
+}
@@ -0,0 +1,138 @@
+// test/test_protocolo/test_main.cpp
+//
+// --- PRUEBAS DEL PROTOCOLO DEL MANDO (pio test -e native) ---
+// Las tramas que arma EmisorMando se leen con protocolo::leerTrama: las
+// muestras anteriores (codificadas como diferencias) deben salir iguales.
+
+#include <unity.h>
+#include "EmisorMando.h"
+#include "Protocolo.h"
+
+using namespace protocolo;
+
+static const uint32_t PERIODO_US = 4000; // Múltiplo de los 400 us de dt: marcas exactas
+
+static MuestraMando_t muestras[MAX_MUESTRAS_ANTERIORES + 1];
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_carga_ida_y_vuelta(void) {
+    uint32_t carga = empaquetarCarga(2, 4095, true, 3);
+    TEST_ASSERT_EQUAL_INT(2, jugadorDe(carga));
+    TEST_ASSERT_EQUAL_INT(4095, ejeDe(carga));
+    TEST_ASSERT_TRUE(botonDe(carga));
+    TEST_ASSERT_EQUAL_INT(3, anterioresDe(carga));
+    TEST_ASSERT_EQUAL_INT(0, ejeDe(empaquetarCarga(1, -5, false, 0)));
+}
+
+void test_primera_trama_sin_anteriores(void) {
+    EmisorMando emisor(1, 3);
+    TramaMando_t trama;
+    int len = emisor.armarTrama(0, 1234, false, trama);
+    TEST_ASSERT_EQUAL_INT(tamanoTrama(0), len);
+
+    CabeceraMando_t cab;
+    TEST_ASSERT_EQUAL_INT(1, leerTrama((const uint8_t *)&trama, len, cab, muestras));
+    TEST_ASSERT_EQUAL_INT(1234, muestras[0].eje);
+    TEST_ASSERT_EQUAL_INT(1, jugadorDe(cab.carga));
+}
+
+// Saltos de extremo a extremo, botón alternado y la marca dando la vuelta
+void test_anteriores_ida_y_vuelta(void) {
+    static const int EJES[] = { 0, 4095, 17, 2048, 4000, 5, 3000 };
+    const int n = sizeof(EJES) / sizeof(EJES[0]);
+    EmisorMando emisor(2, 3);
+    TramaMando_t trama;
+    uint32_t inicio_us = 0x10000UL * US_POR_MARCA - 2 * PERIODO_US; // La marca de 16 bits da la vuelta
+    int len = 0;
+    for (int i = 0; i < n; i++) {
+        len = emisor.armarTrama(inicio_us + i * PERIODO_US, EJES[i], (i & 1) != 0, trama);
+    }
+    TEST_ASSERT_EQUAL_INT(tamanoTrama(3), len);
+
+    CabeceraMando_t cab;
+    TEST_ASSERT_EQUAL_INT(4, leerTrama((const uint8_t *)&trama, len, cab, muestras));
+    for (int k = 0; k < 4; k++) {
+        int i = n - 4 + k; // De la más vieja a la más nueva
+        TEST_ASSERT_EQUAL_INT(EJES[i], muestras[k].eje);
+        TEST_ASSERT_EQUAL_INT((i & 1) != 0, muestras[k].boton);
+        TEST_ASSERT_EQUAL_INT((uint8_t)i, muestras[k].secuencia);
+        TEST_ASSERT_EQUAL_INT(marcaDesdeUs(inicio_us + i * PERIODO_US), muestras[k].marca);
+    }
+}
+
+void test_trama_invalida_se_descarta(void) {
+    EmisorMando emisor(1, 3);
+    TramaMando_t trama;
+    int len = 0;
+    for (int i = 0; i < 4; i++) len = emisor.armarTrama(i * PERIODO_US, 100 * i, false, trama);
+
+    CabeceraMando_t cab;
+    TEST_ASSERT_EQUAL_INT(0, leerTrama((const uint8_t *)&trama, len - 1, cab, muestras));
+    TEST_ASSERT_EQUAL_INT(0, leerTrama((const uint8_t *)&trama, 4, cab, muestras));
+    trama.cabecera.version = PROTOCOLO_VERSION + 1;
+    TEST_ASSERT_EQUAL_INT(0, leerTrama((const uint8_t *)&trama, len, cab, muestras));
+}
+
+// Tras el último cambio salen todavía 'anteriores' tramas al ritmo de las
+// muestras, y todas llevan ese cambio; después, solo el mantenimiento
+void test_cambio_viaja_en_las_tramas_siguientes(void) {
+    const int ANTERIORES = 3;
+    const uint32_t MUESTRA_MS = 5;
+    EmisorMando emisor(1, ANTERIORES);
+    TramaMando_t trama;
+    CabeceraMando_t cab;
+    uint32_t ahora_ms = 0;
+
+    // Movimiento y el último cambio (secuencia 2)
+    for (int i = 0; i < 3; i++, ahora_ms += MUESTRA_MS) {
+        TEST_ASSERT_TRUE(emisor.debeEnviar(ahora_ms, 1000 + 100 * i, false));
+        emisor.armarTrama(ahora_ms * 1000, 1000 + 100 * i, false, trama);
+    }
+    for (int i = 0; i < ANTERIORES; i++, ahora_ms += MUESTRA_MS) {
+        TEST_ASSERT_TRUE(emisor.debeEnviar(ahora_ms, 1200, false));
+        int len = emisor.armarTrama(ahora_ms * 1000, 1200, false, trama);
+        int n = leerTrama((const uint8_t *)&trama, len, cab, muestras);
+        TEST_ASSERT_EQUAL_INT(ANTERIORES + 1, n);
+        // La muestra del cambio sigue en la trama (de la más vieja a la más nueva)
+        TEST_ASSERT_EQUAL_INT(2, muestras[n - 2 - i].secuencia);
+        TEST_ASSERT_EQUAL_INT(1200, muestras[n - 2 - i].eje);
+    }
+    TEST_ASSERT_FALSE(emisor.debeEnviar(ahora_ms, 1200, false));
+    uint32_t ultimo_envio_ms = ahora_ms - MUESTRA_MS;
+    TEST_ASSERT_FALSE(emisor.debeEnviar(ultimo_envio_ms + MS_ENTRE_KEEPALIVE - 1, 1200, false));
+    TEST_ASSERT_TRUE(emisor.debeEnviar(ultimo_envio_ms + MS_ENTRE_KEEPALIVE, 1200, false));
+}
+
+// Soltar el botón también es un cambio: no puede quedar presionado en la consola
+void test_soltar_boton_se_repite(void) {
+    const int ANTERIORES = 3;
+    EmisorMando emisor(1, ANTERIORES);
+    TEST_ASSERT_TRUE(emisor.debeEnviar(0, 2048, true));
+    TEST_ASSERT_TRUE(emisor.debeEnviar(5, 2048, false));
+    for (int i = 1; i <= ANTERIORES; i++) {
+        TEST_ASSERT_TRUE(emisor.debeEnviar(5 + 5 * i, 2048, false));
+    }
+    TEST_ASSERT_FALSE(emisor.debeEnviar(5 + 5 * (ANTERIORES + 1), 2048, false));
+}
+
+// Sin muestras anteriores en la trama no hay nada que repetir
+void test_sin_anteriores_no_repite(void) {
+    EmisorMando emisor(1, 0);
+    TEST_ASSERT_TRUE(emisor.debeEnviar(0, 1000, false));
+    TEST_ASSERT_FALSE(emisor.debeEnviar(5, 1000, false));
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_carga_ida_y_vuelta);
+    RUN_TEST(test_primera_trama_sin_anteriores);
+    RUN_TEST(test_anteriores_ida_y_vuelta);
+    RUN_TEST(test_trama_invalida_se_descarta);
+    RUN_TEST(test_cambio_viaja_en_las_tramas_siguientes);
+    RUN_TEST(test_soltar_boton_se_repite);
+    RUN_TEST(test_sin_anteriores_no_repite);
+    return UNITY_END();
+}
@@ -0,0 +1,96 @@
+// comun/EnlaceSimulado/EnlaceSimulado.cpp
+
+#include "EnlaceSimulado.h"
+#include <math.h>
+#include <string.h>
+
+EnlaceSimulado::EnlaceSimulado() {
+    configurar(Config());
+}
+
+EnlaceSimulado::EnlaceSimulado(const Config &c) {
+    configurar(c);
+}
+
+void EnlaceSimulado::configurar(const Config &c) {
+    config = c;
+    estado_rng = c.semilla ? c.semilla : 1;
+    cantidad = 0;
+    ultima_perdida = false;
+}
+
+// xorshift32: la misma semilla da siempre la misma secuencia de eventos
+float EnlaceSimulado::aleatorio01() {
+    estado_rng ^= estado_rng << 13;
+    estado_rng ^= estado_rng >> 17;
+    estado_rng ^= estado_rng << 5;
+    return (estado_rng >> 8) * (1.0f / 16777216.0f);
+}
+
+uint32_t EnlaceSimulado::jitterUs() {
+    if (config.jitter_us == 0) return 0;
+    switch (config.distribucion) {
+        case DISTRIBUCION_NORMAL: {
+            // Box-Muller
+            float u1 = aleatorio01() + 1e-7f;
+            float u2 = aleatorio01();
+            float z = sqrtf(-2.0f * logf(u1)) * cosf(6.2831853f * u2);
+            return (uint32_t)(fabsf(z) * config.jitter_us);
+        }
+        case DISTRIBUCION_EXPONENCIAL:
+            return (uint32_t)(-logf(aleatorio01() + 1e-7f) * config.jitter_us);
+        case DISTRIBUCION_UNIFORME:
+        default:
+            return (uint32_t)(aleatorio01() * config.jitter_us);
+    }
+}
+
+bool EnlaceSimulado::enviar(const uint8_t *datos, int len, uint32_t ahora_us) {
+    if (len <= 0 || len > MAX_BYTES_TRAMA || cantidad == MAX_PENDIENTES) return false;
+    enviadas++;
+
+    // 1. Pérdida (Gilbert): en ráfaga se usa la probabilidad de seguir perdiendo
+    float p = ultima_perdida ? rafagaEfectiva() : config.perdida;
+    if (p > 0.0f && aleatorio01() < p) {
+        perdidas++;
+        ultima_perdida = true;
+        return true; // Para el emisor el envío "salió" igual que con la radio real
+    }
+    ultima_perdida = false;
+
+    // 2. Hora de entrega
+    uint32_t retraso = config.latencia_us + jitterUs();
+    if (config.reorden > 0.0f && aleatorio01() < config.reorden) {
+        retraso += config.retraso_reorden_us;
+        reordenadas++;
+    }
+
+    Pendiente &t = pendientes[cantidad++];
+    t.entrega_us = ahora_us + retraso;
+    t.orden = contador_orden++;
+    t.len = len;
+    memcpy(t.datos, datos, len);
+    return true;
+}
+
+void EnlaceSimulado::entregar(uint32_t ahora_us) {
+    for (;;) {
+        // La vencida más temprana (pocas pendientes: búsqueda lineal)
+        int elegida = -1;
+        for (int i = 0; i < cantidad; i++) {
+            if ((int32_t)(ahora_us - pendientes[i].entrega_us) < 0) continue;
+            if (elegida < 0 ||
+                (int32_t)(pendientes[i].entrega_us - pendientes[elegida].entrega_us) < 0 ||
+                (pendientes[i].entrega_us == pendientes[elegida].entrega_us &&
+                 (int32_t)(pendientes[i].orden - pendientes[elegida].orden) < 0)) {
+                elegida = i;
+            }
+        }
+        if (elegida < 0) return;
+
+        Pendiente t = pendientes[elegida];
+        pendientes[elegida] = pendientes[--cantidad];
+        entregadas++;
+        if (receptor) receptor(t.datos, t.len);
+    }
+}
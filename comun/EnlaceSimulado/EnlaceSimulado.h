@@ -0,0 +1,87 @@
+// comun/EnlaceSimulado/EnlaceSimulado.h
+//
+// --- ENLACE ESP-NOW SIMULADO (solo PC) ---
+// Cola de tramas en proceso con pérdidas, latencia, jitter y desorden
+// configurables y repetibles (generador propio con semilla). Cada trama
+// enviada recibe una hora de entrega; entregar() llama al receptor con las que
+// ya vencieron, en orden de hora de entrega.
+//   - Pérdida: modelo de Gilbert de dos estados. Tras una trama entregada la
+//     siguiente se pierde con probabilidad 'perdida'; tras una pérdida, con
+//     probabilidad 'rafaga'. Si 'rafaga' es negativa (por defecto) vale lo
+//     mismo que 'perdida': pérdidas independientes. 0 = nunca dos seguidas.
+//   - Latencia: latencia_us + jitter según 'distribucion'.
+//   - Desorden: con probabilidad 'reorden' la trama se retrasa además
+//     retraso_reorden_us, así que las siguientes la adelantan.
+// EspNowSimulado.h expone esto con las mismas funciones que esp_now.h.
+
+#ifndef ENLACE_SIMULADO_H
+#define ENLACE_SIMULADO_H
+
+#include <stdint.h>
+
+class EnlaceSimulado {
+public:
+    enum Distribucion {
+        DISTRIBUCION_UNIFORME,    // jitter en [0, jitter_us]
+        DISTRIBUCION_NORMAL,      // |N(0, jitter_us)|
+        DISTRIBUCION_EXPONENCIAL  // media jitter_us: cola larga, como los reintentos de 802.11
+    };
+
+    struct Config {
+        float perdida = 0.0f;
+        float rafaga = -1.0f; // < 0: igual que 'perdida'
+        uint32_t latencia_us = 1500;
+        uint32_t jitter_us = 0;
+        Distribucion distribucion = DISTRIBUCION_UNIFORME;
+        float reorden = 0.0f;
+        uint32_t retraso_reorden_us = 8000;
+        uint32_t semilla = 1;
+    };
+
+    typedef void (*Receptor)(const uint8_t *datos, int len);
+
+    static const int MAX_PENDIENTES = 64;
+    static const int MAX_BYTES_TRAMA = 250; // Límite de ESP-NOW
+
+    EnlaceSimulado();
+    explicit EnlaceSimulado(const Config &config);
+
+    void configurar(const Config &config);
+    void fijarReceptor(Receptor r) { receptor = r; }
+
+    // Probabilidad de perder la trama siguiente a una perdida
+    float rafagaEfectiva() const { return config.rafaga < 0.0f ? config.perdida : config.rafaga; }
+
+    // Pone una trama en el aire. Devuelve false si no cabe (cola o tamaño).
+    bool enviar(const uint8_t *datos, int len, uint32_t ahora_us);
+
+    // Entrega al receptor las tramas cuya hora ya llegó
+    void entregar(uint32_t ahora_us);
+
+    // Estadísticas
+    uint32_t enviadas = 0;
+    uint32_t perdidas = 0;
+    uint32_t reordenadas = 0;
+    uint32_t entregadas = 0;
+
+private:
+    struct Pendiente {
+        uint32_t entrega_us;
+        uint32_t orden; // Desempate: a igual hora, en orden de envío
+        int len;
+        uint8_t datos[MAX_BYTES_TRAMA];
+    };
+
+    float aleatorio01();
+    uint32_t jitterUs();
+
+    Config config;
+    Receptor receptor = nullptr;
+    Pendiente pendientes[MAX_PENDIENTES];
+    int cantidad = 0;
+    uint32_t estado_rng;
+    uint32_t contador_orden = 0;
+    bool ultima_perdida = false;
+};
+
+#endif // ENLACE_SIMULADO_H
@@ -0,0 +1,34 @@
+// comun/EnlaceSimulado/EspNowSimulado.cpp
+
+#include "EspNowSimulado.h"
+
+static EnlaceSimulado enlace_global;
+static esp_now_recv_cb_t receptor_registrado = nullptr;
+static uint32_t reloj_us = 0;
+static const uint8_t MAC_EMISOR[6] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x01};
+
+static void entregarAlCallback(const uint8_t *datos, int len) {
+    if (receptor_registrado) receptor_registrado(MAC_EMISOR, datos, len);
+}
+
+esp_err_t esp_now_send(const uint8_t *peer_addr, const uint8_t *data, size_t len) {
+    (void)peer_addr;
+    return enlace_global.enviar(data, (int)len, reloj_us) ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t esp_now_register_recv_cb(esp_now_recv_cb_t cb) {
+    receptor_registrado = cb;
+    enlace_global.fijarReceptor(entregarAlCallback);
+    return ESP_OK;
+}
+
+namespace espnow_sim {
+
+EnlaceSimulado &enlace() { return enlace_global; }
+
+void procesar(uint32_t ahora_us) {
+    reloj_us = ahora_us;
+    enlace_global.entregar(ahora_us);
+}
+
+} // namespace espnow_sim
@@ -0,0 +1,33 @@
+// comun/EnlaceSimulado/EspNowSimulado.h
+//
+// --- esp_now_send / esp_now_register_recv_cb SOBRE EnlaceSimulado (solo PC) ---
+// Mismas firmas que esp_now.h de ESP-IDF 4.4, para que el código del emisor y
+// el callback OnDataRecv de la consola corran sin cambios contra el enlace
+// simulado. El reloj lo pone quien simula: espnow_sim::procesar(ahora_us)
+// entrega las tramas vencidas y esp_now_send() usa la última hora procesada.
+
+#ifndef ESP_NOW_SIMULADO_H
+#define ESP_NOW_SIMULADO_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "EnlaceSimulado.h"
+
+typedef int esp_err_t;
+#ifndef ESP_OK
+#define ESP_OK 0
+#define ESP_FAIL -1
+#endif
+
+typedef void (*esp_now_recv_cb_t)(const uint8_t *mac_addr, const uint8_t *data, int data_len);
+
+esp_err_t esp_now_send(const uint8_t *peer_addr, const uint8_t *data, size_t len);
+esp_err_t esp_now_register_recv_cb(esp_now_recv_cb_t cb);
+
+namespace espnow_sim {
+EnlaceSimulado &enlace();
+// Avanza el reloj del enlace y entrega lo que toque
+void procesar(uint32_t ahora_us);
+} // namespace espnow_sim
+
+#endif // ESP_NOW_SIMULADO_H
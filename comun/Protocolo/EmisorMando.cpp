@@ -0,0 +1,72 @@
+// comun/Protocolo/EmisorMando.cpp
+
+#include "EmisorMando.h"
+
+EmisorMando::EmisorMando(int jugador, int anteriores)
+    : jugador(jugador),
+      anteriores(anteriores < 0 ? 0 : (anteriores > protocolo::MAX_MUESTRAS_ANTERIORES ? protocolo::MAX_MUESTRAS_ANTERIORES : anteriores)),
+      siguiente(0),
+      guardadas(0),
+      eje_enviado(-1),
+      boton_enviado(false),
+      repeticiones(0),
+      ultimo_envio_ms(0),
+      ultimo_movimiento_ms(0)
+{
+}
+
+bool EmisorMando::debeEnviar(uint32_t ahora_ms, int eje, bool boton) {
+    int diferencia = eje - eje_enviado;
+    if (diferencia < 0) diferencia = -diferencia;
+    bool hay_cambio = (boton != boton_enviado) || diferencia >= UMBRAL_ENVIO;
+    if (hay_cambio || boton) ultimo_movimiento_ms = ahora_ms;
+
+    if (hay_cambio) {
+        repeticiones = anteriores;
+    } else if (repeticiones > 0) {
+        repeticiones--; // Cola del cambio: al ritmo de las muestras
+    } else if ((ahora_ms - ultimo_envio_ms) < protocolo::MS_ENTRE_KEEPALIVE) {
+        return false;
+    }
+
+    eje_enviado = eje;
+    boton_enviado = boton;
+    ultimo_envio_ms = ahora_ms;
+    return true;
+}
+
+int EmisorMando::armarTrama(uint32_t ahora_us, int eje, bool boton, protocolo::TramaMando_t &trama) {
+    if (eje < 0) eje = 0;
+    if (eje > 4095) eje = 4095;
+
+    protocolo::MuestraMando_t nueva;
+    nueva.secuencia = siguiente++;
+    nueva.marca = protocolo::marcaDesdeUs(ahora_us);
+    nueva.eje = eje;
+    nueva.boton = boton;
+
+    int n = guardadas < anteriores ? guardadas : anteriores;
+    trama.cabecera.version = protocolo::PROTOCOLO_VERSION;
+    trama.cabecera.secuencia = nueva.secuencia;
+    trama.cabecera.marca = nueva.marca;
+    trama.cabecera.carga = protocolo::empaquetarCarga(jugador, eje, boton, n);
+
+    // Cada anterior se codifica respecto a la muestra siguiente (más nueva)
+    const protocolo::MuestraMando_t *siguiente_muestra = &nueva;
+    for (int i = 0; i < n; i++) {
+        const protocolo::MuestraMando_t &m = historial[i];
+        uint32_t dt = (uint16_t)(siguiente_muestra->marca - m.marca) / protocolo::MARCAS_POR_DT;
+        trama.anteriores[i].dt = (uint8_t)(dt > 255 ? 255 : dt);
+        trama.anteriores[i].delta = (int16_t)(((siguiente_muestra->eje - m.eje) * 2) | (m.boton ? 1 : 0));
+        siguiente_muestra = &m;
+    }
+
+    // Correr el historial e insertar la nueva al frente
+    if (anteriores > 0) {
+        int ultima = (guardadas < anteriores) ? guardadas : anteriores - 1;
+        for (int i = ultima; i > 0; i--) historial[i] = historial[i - 1];
+        historial[0] = nueva;
+        if (guardadas < anteriores) guardadas++;
+    }
+    return protocolo::tamanoTrama(n);
+}
@@ -0,0 +1,53 @@
+// comun/Protocolo/EmisorMando.h
+//
+// --- ARMADO DE TRAMAS EN EL MANDO ---
+// Numera las muestras y guarda las últimas PROTOCOLO_MUESTRAS_ANTERIORES para
+// repetirlas (como diferencias) en cada trama, y decide cuándo enviar:
+// en movimiento, cada muestra que cambió al menos UMBRAL_ENVIO; después del
+// último cambio, todavía 'anteriores' muestras más (así ese cambio viaja
+// también en las tramas siguientes y perder la suya no se nota); quieto, solo
+// una trama de mantenimiento cada MS_ENTRE_KEEPALIVE. No depende del
+// hardware: lo usa PALETA y también el simulador de enlace del PC.
+
+#ifndef EMISOR_MANDO_H
+#define EMISOR_MANDO_H
+
+#include "Protocolo.h"
+
+class EmisorMando {
+public:
+    static const int UMBRAL_ENVIO = 6; // Cuentas del eje (~0.1 grados en PALETA)
+
+    explicit EmisorMando(int jugador, int anteriores = PROTOCOLO_MUESTRAS_ANTERIORES);
+
+    // true si esta muestra debe salir (cambió, sigue a un cambio o toca
+    // mantenimiento); en ese caso la da por enviada. Llamar una vez por muestra.
+    bool debeEnviar(uint32_t ahora_ms, int eje, bool boton);
+
+    // Tiempo sin movimiento ni botón presionado (para decidir dormir)
+    uint32_t msSinMovimiento(uint32_t ahora_ms) const { return ahora_ms - ultimo_movimiento_ms; }
+
+    // Agrega la muestra nueva y arma la trama en 'trama'. Devuelve los bytes a enviar.
+    int armarTrama(uint32_t ahora_us, int eje, bool boton, protocolo::TramaMando_t &trama);
+
+    // La secuencia sigue tras un Deep Sleep si se guarda y se restaura
+    uint8_t secuencia() const { return siguiente; }
+    void fijarSecuencia(uint8_t s) { siguiente = s; guardadas = 0; }
+
+private:
+    int jugador;
+    int anteriores;
+    uint8_t siguiente;
+    // Últimas muestras enviadas; [0] es la más nueva
+    protocolo::MuestraMando_t historial[protocolo::MAX_MUESTRAS_ANTERIORES];
+    int guardadas;
+
+    // Envío adaptativo
+    int eje_enviado;
+    bool boton_enviado;
+    int repeticiones; // Muestras que aún salen tras el último cambio
+    uint32_t ultimo_envio_ms;
+    uint32_t ultimo_movimiento_ms;
+};
+
+#endif // EMISOR_MANDO_H
@@ -0,0 +1,57 @@
+// comun/Protocolo/EstadisticasEnlace.cpp
+
+#include "EstadisticasEnlace.h"
+#include "Protocolo.h"
+
+EstadisticasEnlace::EstadisticasEnlace() {
+    reiniciar();
+}
+
+void EstadisticasEnlace::reiniciar() {
+    recibidas = 0;
+    perdidas = 0;
+    fuera_de_orden = 0;
+    recuperadas = 0;
+    max_entre_llegadas_us = 0;
+    primera = true;
+    ultima_secuencia = 0;
+    ultima_marca = 0;
+    ultima_llegada_us = 0;
+    jitter_x16 = 0;
+}
+
+bool EstadisticasEnlace::registrar(uint8_t secuencia, uint16_t marca, uint32_t llegada_us) {
+    if (primera) {
+        primera = false;
+    } else {
+        // Diferencia con signo módulo 256: positiva = más nueva que la última
+        int8_t salto = (int8_t)(uint8_t)(secuencia - ultima_secuencia);
+        if (salto <= 0) {
+            fuera_de_orden++;
+            if (salto < 0 && perdidas > 0) perdidas--; // Llegó tarde: no se había perdido
+            return false;
+        }
+        perdidas += (uint32_t)(salto - 1);
+
+        // Tránsito relativo: (llegada_j - llegada_i) - (envío_j - envío_i)
+        uint32_t entre_llegadas = llegada_us - ultima_llegada_us;
+        uint32_t entre_envios = (uint32_t)(uint16_t)(marca - ultima_marca) * protocolo::US_POR_MARCA;
+        int32_t d = (int32_t)(entre_llegadas - entre_envios);
+        uint32_t d_abs = (uint32_t)(d < 0 ? -d : d);
+        // J += (|D| - J) / 16, con J guardado x16
+        jitter_x16 += d_abs - ((jitter_x16 + 8) >> 4);
+
+        if (entre_llegadas > max_entre_llegadas_us) max_entre_llegadas_us = entre_llegadas;
+    }
+
+    recibidas++;
+    ultima_secuencia = secuencia;
+    ultima_marca = marca;
+    ultima_llegada_us = llegada_us;
+    return true;
+}
+
+uint32_t EstadisticasEnlace::perdidaPorMil() const {
+    uint32_t esperadas = recibidas + perdidas;
+    return esperadas ? (uint32_t)((uint64_t)perdidas * 1000 / esperadas) : 0;
+}
@@ -0,0 +1,55 @@
+// comun/Protocolo/EstadisticasEnlace.h
+//
+// --- CALIDAD DEL ENLACE DE UN MANDO ---
+// Se alimenta con cada trama recibida (secuencia, marca del emisor y hora de
+// llegada en el receptor) y cuenta:
+//   - perdidas: huecos en la secuencia (se restan si la trama llega tarde)
+//   - fuera_de_orden: tramas con secuencia vieja o repetida (se descartan)
+//   - recuperadas: muestras de tramas perdidas que llegaron repetidas en una
+//     trama posterior (las anota el receptor con contarRecuperada())
+//   - jitter: variación del tiempo de tránsito entre llegadas, con el
+//     estimador de RFC 3550 (J += (|D| - J) / 16)
+// Un solo escritor (el callback de recepción); leer los contadores desde otra
+// tarea da valores aproximados, suficiente para los informes.
+
+#ifndef ESTADISTICAS_ENLACE_H
+#define ESTADISTICAS_ENLACE_H
+
+#include <stdint.h>
+
+class EstadisticasEnlace {
+public:
+    EstadisticasEnlace();
+
+    // Registra una trama. Devuelve false si es vieja o repetida (descartarla).
+    bool registrar(uint8_t secuencia, uint16_t marca, uint32_t llegada_us);
+
+    void contarRecuperada() { recuperadas++; }
+
+    // Tras un silencio largo (mando dormido o reiniciado) la próxima trama se
+    // toma como primera, sin compararla con la secuencia vieja. Conserva los contadores.
+    void resincronizar() { primera = true; }
+    uint32_t ultimaLlegadaUs() const { return ultima_llegada_us; }
+
+    // Pone los contadores a cero (el próximo paquete vuelve a ser el primero)
+    void reiniciar();
+
+    uint32_t jitterUs() const { return jitter_x16 >> 4; }
+    // Pérdida en milésimas (0-1000) sobre lo esperado
+    uint32_t perdidaPorMil() const;
+
+    uint32_t recibidas;
+    uint32_t perdidas;
+    uint32_t fuera_de_orden;
+    uint32_t recuperadas;
+    uint32_t max_entre_llegadas_us; // Mayor hueco entre dos tramas aceptadas
+
+private:
+    bool primera;
+    uint8_t ultima_secuencia;
+    uint16_t ultima_marca;
+    uint32_t ultima_llegada_us;
+    uint32_t jitter_x16; // Jitter en us con 4 bits de fracción
+};
+
+#endif // ESTADISTICAS_ENLACE_H
@@ -0,0 +1,140 @@
+// comun/Protocolo/Protocolo.h
+//
+// --- PROTOCOLO MANDO -> CONSOLA (ESP-NOW) ---
+// Cabecera compartida por PALETA (emisor) y PINGPONG (receptor); ambos la
+// toman con lib_extra_dirs = ../comun en su platformio.ini.
+//
+// Cada trama lleva la muestra nueva completa y, para tapar pérdidas sin
+// reenvíos, las anteriores codificadas como diferencias. Little-endian (ESP32):
+//   byte 0     version    PROTOCOLO_VERSION; las tramas de otra versión se descartan
+//   byte 1     secuencia  de la muestra nueva: +1 por muestra enviada (da la vuelta en 255)
+//   bytes 2-3  marca      reloj del mando en unidades de 100 us (da la vuelta cada 6,5 s)
+//   bytes 4-7  carga      bits 0-11 eje (0-4095), bits 12-13 jugador (1-2),
+//                         bit 14 botón, bit 15 reservado (0),
+//                         bits 16-18 cuántas muestras anteriores siguen (0-7),
+//                         bits 19-31 reservados (0)
+//   3 bytes por muestra anterior, de la más nueva a la más vieja (secuencia - 1, - 2, ...):
+//     byte 0     dt      tiempo hasta la muestra siguiente, en unidades de 400 us (satura en 255)
+//     bytes 1-2  delta   int16: bit 0 botón, bits 1-15 (con signo) eje_siguiente - eje
+// La integridad la cubre el FCS de 802.11 que ESP-NOW ya verifica; no hay suma propia.
+
+#ifndef PROTOCOLO_H
+#define PROTOCOLO_H
+
+#include <stdint.h>
+#include <string.h>
+
+namespace protocolo {
+
+const uint8_t PROTOCOLO_VERSION = 2;
+const uint32_t US_POR_MARCA = 100;
+const uint32_t MARCAS_POR_DT = 4; // dt de las muestras anteriores: 400 us
+
+// El mando quieto solo manda una trama de mantenimiento cada MS_ENTRE_KEEPALIVE;
+// la consola da el mando por desconectado tras MS_MANDO_INACTIVO sin tramas
+// (tolera perder dos seguidas).
+const uint32_t MS_ENTRE_KEEPALIVE = 50;
+const uint32_t MS_MANDO_INACTIVO = 3 * MS_ENTRE_KEEPALIVE;
+
+// Muestras anteriores que viajan en cada trama. Con 3, se pueden perder hasta
+// 3 tramas seguidas sin que falte ninguna muestra (ni ningún flanco del botón).
+const int MAX_MUESTRAS_ANTERIORES = 7;
+#ifndef PROTOCOLO_MUESTRAS_ANTERIORES
+#define PROTOCOLO_MUESTRAS_ANTERIORES 3
+#endif
+
+typedef struct {
+    uint8_t version;
+    uint8_t secuencia;
+    uint16_t marca;
+    uint32_t carga;
+} __attribute__((packed)) CabeceraMando_t;
+
+typedef struct {
+    uint8_t dt;
+    int16_t delta;
+} __attribute__((packed)) MuestraAnterior_t;
+
+typedef struct {
+    CabeceraMando_t cabecera;
+    MuestraAnterior_t anteriores[MAX_MUESTRAS_ANTERIORES];
+} __attribute__((packed)) TramaMando_t;
+
+static_assert(sizeof(CabeceraMando_t) == 8, "La cabecera del mando debe medir 8 bytes");
+static_assert(sizeof(MuestraAnterior_t) == 3, "Cada muestra anterior debe medir 3 bytes");
+
+// Una muestra ya decodificada
+typedef struct {
+    uint8_t secuencia;
+    uint16_t marca; // Unidades de 100 us del reloj del mando
+    int eje;        // 0-4095
+    bool boton;
+} MuestraMando_t;
+
+// --- Carga de 4 bytes ---
+const uint32_t MASCARA_EJE = 0x0FFF;
+const int BIT_JUGADOR = 12;
+const uint32_t MASCARA_JUGADOR = 0x3;
+const uint32_t BIT_BOTON = 1UL << 14;
+const int BIT_ANTERIORES = 16;
+const uint32_t MASCARA_ANTERIORES = 0x7;
+
+inline uint32_t empaquetarCarga(int jugador, int eje, bool boton, int anteriores) {
+    if (eje < 0) eje = 0;
+    if (eje > 4095) eje = 4095;
+    return ((uint32_t)eje & MASCARA_EJE) |
+           (((uint32_t)jugador & MASCARA_JUGADOR) << BIT_JUGADOR) |
+           (boton ? BIT_BOTON : 0) |
+           (((uint32_t)anteriores & MASCARA_ANTERIORES) << BIT_ANTERIORES);
+}
+
+inline int ejeDe(uint32_t carga) { return (int)(carga & MASCARA_EJE); }
+inline int jugadorDe(uint32_t carga) { return (int)((carga >> BIT_JUGADOR) & MASCARA_JUGADOR); }
+inline bool botonDe(uint32_t carga) { return (carga & BIT_BOTON) != 0; }
+inline int anterioresDe(uint32_t carga) { return (int)((carga >> BIT_ANTERIORES) & MASCARA_ANTERIORES); }
+
+// Marca de 16 bits a partir de micros() del emisor
+inline uint16_t marcaDesdeUs(uint32_t us) { return (uint16_t)(us / US_POR_MARCA); }
+
+// Bytes que ocupa en el aire una trama con 'anteriores' muestras extra
+inline int tamanoTrama(int anteriores) {
+    return (int)(sizeof(CabeceraMando_t) + anteriores * sizeof(MuestraAnterior_t));
+}
+
+// Valida una trama recibida (tamaño y versión) y reconstruye sus muestras en
+// 'muestras' (capacidad MAX_MUESTRAS_ANTERIORES + 1), de la más vieja a la
+// más nueva. Devuelve cuántas hay; 0 si la trama no es válida.
+inline int leerTrama(const uint8_t *datos, int len, CabeceraMando_t &cab, MuestraMando_t *muestras) {
+    if (datos == NULL || len < (int)sizeof(CabeceraMando_t)) return 0;
+    memcpy(&cab, datos, sizeof(CabeceraMando_t));
+    if (cab.version != PROTOCOLO_VERSION) return 0;
+
+    int anteriores = anterioresDe(cab.carga);
+    if (len < tamanoTrama(anteriores)) return 0;
+
+    // La nueva va al final; las anteriores se deshacen hacia atrás
+    MuestraMando_t m;
+    m.secuencia = cab.secuencia;
+    m.marca = cab.marca;
+    m.eje = ejeDe(cab.carga);
+    m.boton = botonDe(cab.carga);
+    muestras[anteriores] = m;
+
+    const uint8_t *p = datos + sizeof(CabeceraMando_t);
+    for (int i = 1; i <= anteriores; i++, p += sizeof(MuestraAnterior_t)) {
+        MuestraAnterior_t a;
+        memcpy(&a, p, sizeof(a));
+        m.secuencia = (uint8_t)(m.secuencia - 1);
+        m.marca = (uint16_t)(m.marca - a.dt * MARCAS_POR_DT);
+        m.eje -= (a.delta >> 1); // Desplazamiento aritmético: conserva el signo
+        if (m.eje < 0) m.eje = 0;
+        if (m.eje > 4095) m.eje = 4095;
+        m.boton = (a.delta & 1) != 0;
+        muestras[anteriores - i] = m;
+    }
+    return anteriores + 1;
+}
+
+} // namespace protocolo
+
+#endif // PROTOCOLO_H